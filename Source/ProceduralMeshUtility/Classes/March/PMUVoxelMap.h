@@ -28,6 +28,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
 #include "March/PMUVoxelTypes.h"
 #include "Mesh/PMUMeshTypes.h"
 #include "PMUGridData.h"
@@ -35,6 +36,7 @@
 #include "PMUVoxelMap.generated.h"
 
 class FPMUVoxelGrid;
+struct FPMUVoxelMapSource;
 
 class FPMUVoxelMap
 {
@@ -61,6 +63,42 @@ private:
     float voxelSize;
     bool bHasGridData = false;
 
+    class FQueuedThreadPool* simplifyThreadPool = nullptr;
+
+    // Streaming state, chunk access times drive LRU eviction
+
+    TArray<uint64> chunkAccessTimes;
+    TBitArray<> evictedChunks;
+    uint64 accessClock = 0;
+    int32 materializeCount = 0;
+    int32 evictCount = 0;
+    FString streamingDirectory;
+    mutable FCriticalSection chunkLock;
+
+    // Loaded map file, mapped chunk records are decoded on acquisition
+
+    TSharedPtr<FPMUVoxelMapSource> mapSource;
+    TBitArray<> mappedChunks;
+
+    FORCEINLINE bool HasLazyChunks() const
+    {
+        return bStreamChunks || mapSource.IsValid();
+    }
+
+    void InitializeStreaming();
+    void ClearStreaming();
+    void MaterializeChunk(int32 i);
+    bool DecodeChunk(int32 i, FArchive& Ar, int32 Version);
+    void EvictChunk(int32 i);
+    FString GetChunkStreamingPath(int32 i) const;
+
+    void UpdateChunkBorderLODs(int32 x, int32 y);
+    void UpdateChunkNeighbourLODs(int32 ChunkIndex);
+
+    void GetWeldChunkSet(const TArray<int32>& ChunkIndices, TArray<int32>& OutChunkIndices, TBitArray<>& OutChunkSet) const;
+    uint8 GetWeldBorders(int32 ChunkIndex, const TBitArray<>& ChunkSet) const;
+    bool GetWeldKey(int32 ChunkIndex, uint8 Borders, const FPMUMeshVertex& Vertex, FIntVector& OutKey) const;
+
     void InitializeSettings();
     void InitializeChunkSettings(int32 i, int32 x, int32 y, FPMUVoxelGridConfig& ChunkConfig);
     void InitializeChunk(int32 i, const FPMUVoxelGridConfig& ChunkConfig);
@@ -85,9 +123,34 @@ public:
 	int32 chunkResolution = 2;
 	float extrusionHeight = -1.f;
 
+    // Number of row bands each chunk triangulation is split into,
+    // bands are triangulated in parallel within a single chunk
+
+    int32 triangulationBands = 1;
+
+    // Publish raw chunk triangulation on refresh and simplify surfaces
+    // on the background thread pool, see ApplySimplifiedSections()
+
+    bool bDeferSimplification = false;
+
+    // Store quantized signed distances per voxel instead of edge crossings.
+    // Stencils write distances in a single pass and crossings are derived
+    // from neighbouring voxel distances on triangulation.
+
+    bool bSignedDistance = false;
+
     TArray<FPMUVoxelSurfaceState> surfaceStates;
     TArray<class UStaticMesh*> meshPrefabs;
 
+    // Streaming mode only allocates chunks around the focus points,
+    // idle chunks are written to disk and evicted once the resident
+    // chunk memory exceeds the memory budget (in bytes, zero is unlimited)
+
+    bool bStreamChunks = false;
+    int64 streamingMemoryBudget = 0;
+    float streamingRadius = 0.f;
+    TArray<FVector2D> streamingFocusPoints;
+
     FPMUGridData* GridData = nullptr;
 
 #ifdef PMU_VOXEL_USE_OCL
@@ -100,6 +163,11 @@ public:
     void CopyFrom(const FPMUVoxelMap& VoxelMap);
     void Clear();
 
+    // SERIALIZATION FUNCTIONS
+
+    bool Save(const FString& Filename);
+    bool Load(const FString& Filename);
+
     TSharedPtr<FGWTAsyncThreadPool> GetThreadPool();
 
     FORCEINLINE float GetVoxelSize() const
@@ -122,6 +190,58 @@ public:
     void ResetChunkStates(const TArray<int32>& ChunkIndices);
     void ResetAllChunkStates();
 
+    // STREAMING FUNCTIONS
+    //
+    // UpdateStreaming() may free chunk data and must not run while
+    // edit or triangulation tasks on this map are still in flight
+
+    bool IsChunkResident(int32 ChunkIndex) const;
+    FPMUVoxelGrid& AcquireChunk(int32 ChunkIndex);
+    void UpdateStreaming(TArray<int32>& OutMaterializedChunks, TArray<int32>& OutEvictedChunks);
+    void GetResidencyStats(FPMUVoxelMapResidencyStats& OutStats) const;
+
+    // DIRTY CHUNK FUNCTIONS
+
+    bool IsChunkDirty(int32 ChunkIndex) const;
+    void MarkChunkDirty(int32 x, int32 y);
+    void MarkAllChunksDirty();
+    void GetDirtyChunks(TArray<int32>& OutChunkIndices) const;
+    void RefreshDirtyChunks(TArray<int32>& OutChunkIndices);
+    void RefreshDirtyChunksAsync(FGWTAsyncTaskRef& TaskRef, TArray<int32>& OutChunkIndices);
+
+    // DEFERRED SIMPLIFICATION FUNCTIONS
+    //
+    // Swaps completed simplified sections into chunk renderers and returns
+    // the updated chunks. Must not run while refresh tasks are in flight.
+
+    void ApplySimplifiedSections(TArray<int32>& OutChunkIndices);
+    int32 GetPendingSimplificationCount() const;
+
+    // Geometry Buffer Functions
+
+    void ShrinkChunkBuffers();
+    int32 GetBufferAllocationCount() const;
+
+    // LOD FUNCTIONS
+    //
+    // Chunks above LOD 0 are triangulated from voxel states sampled every
+    // 2, 4 or 8 voxels. Chunk border vertices that do not exist on coarser
+    // neighbour borders are stitched onto the neighbour border edges.
+    // Changed chunks and their neighbours are marked dirty.
+
+    int32 SetChunkLOD(int32 ChunkIndex, int32 LODLevel);
+    int32 GetChunkLOD(int32 ChunkIndex) const;
+
+    // BORDER WELDING FUNCTIONS
+    //
+    // Neighbouring chunk sections duplicate vertices along shared chunk
+    // borders. Welding either merges chunk sections into a single section
+    // or unifies normals of duplicated border vertices in chunk sections.
+    // Empty chunk index list welds every resident chunk.
+
+    void GetWeldedSection(const TArray<int32>& ChunkIndices, int32 StateIndex, FPMUMeshSection& OutSection, FPMUVoxelWeldStats& OutStats) const;
+    void WeldChunkBorderNormals(const TArray<int32>& ChunkIndices, int32 StateIndex, FPMUVoxelWeldStats& OutStats);
+
     // PREFAB FUNCTIONS
 
 	FORCEINLINE bool HasPrefab(int32 PrefabIndex) const
@@ -187,9 +307,27 @@ public:
     UPROPERTY(EditAnywhere, Category="Map Settings", BlueprintReadWrite)
 	float MaxParallelAngle = 8.f;
 
+    UPROPERTY(EditAnywhere, Category="Map Settings", BlueprintReadWrite, meta=(ClampMin="1", UIMin="1"))
+	int32 TriangulationBands = 1;
+
+    UPROPERTY(EditAnywhere, Category="Map Settings", BlueprintReadWrite)
+	bool bDeferSimplification = false;
+
+    UPROPERTY(EditAnywhere, Category="Map Settings", BlueprintReadWrite)
+	bool bSignedDistance = false;
+
     UPROPERTY(BlueprintReadWrite, Category="Prefabs")
     TArray<class UStaticMesh*> MeshPrefabs;
 
+    UPROPERTY(EditAnywhere, Category="Streaming", BlueprintReadWrite)
+    bool bStreamChunks = false;
+
+    UPROPERTY(EditAnywhere, Category="Streaming", BlueprintReadWrite, meta=(ClampMin="0", UIMin="0"))
+    float StreamingMemoryBudgetMB = 0.f;
+
+    UPROPERTY(EditAnywhere, Category="Streaming", BlueprintReadWrite, meta=(ClampMin="0", UIMin="0"))
+    float StreamingRadius = 0.f;
+
     UPROPERTY(BlueprintReadWrite, Category="GPU Settings")
     bool bUseGPUProgram = false;
 
@@ -258,6 +396,12 @@ public:
         }
     }
 
+    UFUNCTION(BlueprintCallable)
+    bool SaveVoxelMap(const FString& Filename);
+
+    UFUNCTION(BlueprintCallable)
+    bool LoadVoxelMap(const FString& Filename);
+
     UFUNCTION(BlueprintCallable)
     void Triangulate()
     {
@@ -270,9 +414,101 @@ public:
         return VoxelMap.RefreshAllChunksAsync(TaskRef);
     }
 
+    UFUNCTION(BlueprintCallable)
+    TArray<int32> TriangulateDirty()
+    {
+        TArray<int32> ChunkIndices;
+        VoxelMap.RefreshDirtyChunks(ChunkIndices);
+        return ChunkIndices;
+    }
+
+    UFUNCTION(BlueprintCallable)
+    TArray<int32> TriangulateDirtyAsync(UPARAM(ref) FGWTAsyncTaskRef& TaskRef)
+    {
+        TArray<int32> ChunkIndices;
+        VoxelMap.RefreshDirtyChunksAsync(TaskRef, ChunkIndices);
+        return ChunkIndices;
+    }
+
+    UFUNCTION(BlueprintCallable)
+    TArray<int32> GetDirtyChunks() const
+    {
+        TArray<int32> ChunkIndices;
+        VoxelMap.GetDirtyChunks(ChunkIndices);
+        return ChunkIndices;
+    }
+
+    UFUNCTION(BlueprintCallable)
+    TArray<int32> ApplySimplifiedSections()
+    {
+        TArray<int32> ChunkIndices;
+        VoxelMap.ApplySimplifiedSections(ChunkIndices);
+        return ChunkIndices;
+    }
+
+    UFUNCTION(BlueprintCallable)
+    int32 GetPendingSimplificationCount() const
+    {
+        return VoxelMap.GetPendingSimplificationCount();
+    }
+
+    UFUNCTION(BlueprintCallable)
+    void ShrinkGeometryBuffers()
+    {
+        VoxelMap.ShrinkChunkBuffers();
+    }
+
+    UFUNCTION(BlueprintCallable)
+    int32 GetBufferAllocationCount() const
+    {
+        return VoxelMap.GetBufferAllocationCount();
+    }
+
+    UFUNCTION(BlueprintCallable)
+    void SetStreamingFocusPoints(const TArray<FVector2D>& FocusPoints)
+    {
+        VoxelMap.streamingFocusPoints = FocusPoints;
+    }
+
+    UFUNCTION(BlueprintCallable)
+    void UpdateStreaming(TArray<int32>& OutMaterializedChunks, TArray<int32>& OutEvictedChunks);
+
+    UFUNCTION(BlueprintCallable)
+    FPMUVoxelMapResidencyStats GetResidencyStats() const
+    {
+        FPMUVoxelMapResidencyStats Stats;
+        VoxelMap.GetResidencyStats(Stats);
+        return Stats;
+    }
+
+	UFUNCTION(BlueprintCallable)
+	bool IsChunkResident(int32 ChunkIndex) const
+    {
+        return VoxelMap.IsChunkResident(ChunkIndex);
+    }
+
+    // Sets chunk target LOD, returns the LOD level applied to the chunk
+	UFUNCTION(BlueprintCallable)
+	int32 SetChunkLOD(int32 ChunkIndex, int32 LODLevel)
+    {
+        return VoxelMap.SetChunkLOD(ChunkIndex, LODLevel);
+    }
+
+	UFUNCTION(BlueprintCallable)
+	int32 GetChunkLOD(int32 ChunkIndex) const
+    {
+        return VoxelMap.GetChunkLOD(ChunkIndex);
+    }
+
     UFUNCTION(BlueprintCallable)
     void EditMapAsync(UPARAM(ref) FGWTAsyncTaskRef& TaskRef, const TArray<UPMUVoxelStencilRef*>& Stencils);
 
+    UFUNCTION(BlueprintCallable)
+    void EditMapBatched(const TArray<UPMUVoxelStencilRef*>& Stencils);
+
+    UFUNCTION(BlueprintCallable)
+    void EditMapBatchedAsync(UPARAM(ref) FGWTAsyncTaskRef& TaskRef, const TArray<UPMUVoxelStencilRef*>& Stencils);
+
     UFUNCTION(BlueprintCallable)
     void EditStatesAsync(UPARAM(ref) FGWTAsyncTaskRef& TaskRef, const TArray<UPMUVoxelStencilRef*>& Stencils);
 
@@ -327,6 +563,12 @@ public:
 	UFUNCTION(BlueprintCallable)
 	FPMUMeshSection GetSection(int32 ChunkIndex, int32 StateIndex) const;
 
+	UFUNCTION(BlueprintCallable)
+	FPMUMeshSection GetWeldedSection(const TArray<int32>& ChunkIndices, int32 StateIndex, FPMUVoxelWeldStats& OutStats) const;
+
+	UFUNCTION(BlueprintCallable)
+	FPMUVoxelWeldStats WeldChunkBorderNormals(const TArray<int32>& ChunkIndices, int32 StateIndex);
+
     // PREFAB FUNCTIONS
 
 	UFUNCTION(BlueprintCallable)
@@ -377,9 +619,27 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	float MaxParallelAngle = 8.f;
 
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="1", UIMin="1"))
+	int32 TriangulationBands = 1;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bDeferSimplification = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bSignedDistance = false;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     TArray<class UStaticMesh*> MeshPrefabs;
 
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bStreamChunks = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0"))
+    float StreamingMemoryBudgetMB = 0.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0"))
+    float StreamingRadius = 0.f;
+
     UFUNCTION(BlueprintCallable)
     void ApplySettings(UPMUVoxelMapRef* MapRef) const
     {
@@ -393,7 +653,13 @@ public:
             MapRef->ExtrusionHeight = ExtrusionHeight;
             MapRef->MaxFeatureAngle = MaxFeatureAngle;
             MapRef->MaxParallelAngle = MaxParallelAngle;
+            MapRef->TriangulationBands = TriangulationBands;
+            MapRef->bDeferSimplification = bDeferSimplification;
+            MapRef->bSignedDistance = bSignedDistance;
             MapRef->MeshPrefabs = MeshPrefabs;
+            MapRef->bStreamChunks = bStreamChunks;
+            MapRef->StreamingMemoryBudgetMB = StreamingMemoryBudgetMB;
+            MapRef->StreamingRadius = StreamingRadius;
         }
     }
 };
@@ -33,8 +33,21 @@
 #include "PMUVoxelStencil.generated.h"
 
 class FPMUVoxelGrid;
+class FPMUVoxelStencil;
 struct FPMUVoxel;
 
+struct FPMUVoxelStencilInstance
+{
+    FPMUVoxelStencil* Stencil;
+    FVector2D Center;
+
+    FPMUVoxelStencilInstance(FPMUVoxelStencil* InStencil, const FVector2D& InCenter)
+        : Stencil(InStencil)
+        , Center(InCenter)
+    {
+    }
+};
+
 class FPMUVoxelStencil
 {
 protected:
@@ -46,54 +59,56 @@ protected:
 	static void ValidateHorizontalNormal(FPMUVoxel& xMin, const FPMUVoxel& xMax);
 	static void ValidateVerticalNormal(FPMUVoxel& yMin, const FPMUVoxel& yMax);
 
-    void GetMapRange(int32& x0, int32& x1, int32& y0, int32& y1, const float voxelSize, const float chunkSize, const int32 chunkResolution) const
+    void GetMapRange(int32& x0, int32& x1, int32& y0, int32& y1, const float voxelSize, const float chunkSize, const int32 chunkResolution, const int32 padding = 1) const
     {
-        x0 = (int32)((GetXStart() - voxelSize) / chunkSize);
+        const float paddingSize = voxelSize * padding;
+
+        x0 = (int32)((GetXStart() - paddingSize) / chunkSize);
         if (x0 < 0)
         {
             x0 = 0;
         }
 
-        x1 = (int32)((GetXEnd() + voxelSize) / chunkSize);
+        x1 = (int32)((GetXEnd() + paddingSize) / chunkSize);
         if (x1 >= chunkResolution)
         {
             x1 = chunkResolution - 1;
         }
 
-        y0 = (int32)((GetYStart() - voxelSize) / chunkSize);
+        y0 = (int32)((GetYStart() - paddingSize) / chunkSize);
         if (y0 < 0)
         {
             y0 = 0;
         }
 
-        y1 = (int32)((GetYEnd() + voxelSize) / chunkSize);
+        y1 = (int32)((GetYEnd() + paddingSize) / chunkSize);
         if (y1 >= chunkResolution)
         {
             y1 = chunkResolution - 1;
         }
     }
 
-    void GetChunkRange(int32& x0, int32& x1, int32& y0, int32& y1, const float voxelSize, const int32 resolution) const
+    void GetChunkRange(int32& x0, int32& x1, int32& y0, int32& y1, const float voxelSize, const int32 resolution, const int32 padding = 0) const
     {
-        x0 = (int32)(GetXStart() / voxelSize);
+        x0 = (int32)(GetXStart() / voxelSize) - padding;
         if (x0 < 0)
         {
             x0 = 0;
         }
 
-        x1 = (int32)(GetXEnd() / voxelSize);
+        x1 = (int32)(GetXEnd() / voxelSize) + padding;
         if (x1 >= resolution)
         {
             x1 = resolution - 1;
         }
 
-        y0 = (int32)(GetYStart() / voxelSize);
+        y0 = (int32)(GetYStart() / voxelSize) - padding;
         if (y0 < 0)
         {
             y0 = 0;
         }
 
-        y1 = (int32)(GetYEnd() / voxelSize);
+        y1 = (int32)(GetYEnd() / voxelSize) + padding;
         if (y1 >= resolution)
         {
             y1 = resolution - 1;
@@ -158,6 +173,20 @@ public:
     virtual void GetChunkIndices(FPMUVoxelMap& Map, const FVector2D& center, TArray<int32>& OutIndices);
 
     virtual void ApplyVoxel(FPMUVoxel& voxel) const;
+
+    // Signed distance to the stencil border, negative inside the stencil.
+    // Defaults to the distance to the stencil bounds.
+    virtual float GetDistance(const FVector2D& position) const;
+
+    // Create stencil copy that could be positioned independently,
+    // used by batched edits to apply a stencil on multiple chunks in parallel
+    virtual TSharedRef<FPMUVoxelStencil> Clone() const = 0;
+
+    // Apply multiple stencils in order. Stencils are binned by the chunks
+    // they overlap and every chunk applies its stencils on a separate task,
+    // first for voxel states and then for voxel crossings. Signed distance
+    // maps skip the crossing pass.
+    static void EditMapBatched(FPMUVoxelMap& Map, const TArray<FPMUVoxelStencilInstance>& Stencils);
 };
 
 UCLASS(BlueprintType)
@@ -210,6 +239,10 @@ public:
     {
     }
 
+    virtual void GetStencilInstances(TArray<FPMUVoxelStencilInstance>& OutStencils)
+    {
+    }
+
     virtual void EditMapAt(FPMUVoxelMap& Map, const FVector2D& Center)
     {
     }
@@ -85,6 +85,11 @@ struct PROCEDURALMESHUTILITY_API FPMUVoxelSurfaceState
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     bool bExtrusionSurface  = false;
 
+    // Collapse uniformly filled cells into large quads. Merged quads only
+    // have vertices on their perimeter, intended for flat surfaces.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bMergeInteriorCells = false;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     FPMUMeshSimplifierOptions SimplifierOptions;
 
@@ -92,6 +97,51 @@ struct PROCEDURALMESHUTILITY_API FPMUVoxelSurfaceState
     FPMUVoxelGradientConfig GradientConfig;
 };
 
+USTRUCT(BlueprintType)
+struct PROCEDURALMESHUTILITY_API FPMUVoxelMapResidencyStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly)
+    int32 ChunkCount = 0;
+
+    UPROPERTY(BlueprintReadOnly)
+    int32 ResidentChunkCount = 0;
+
+    UPROPERTY(BlueprintReadOnly)
+    int32 EvictedChunkCount = 0;
+
+    UPROPERTY(BlueprintReadOnly)
+    float ResidentMemoryMB = 0.f;
+
+    UPROPERTY(BlueprintReadOnly)
+    float MemoryBudgetMB = 0.f;
+
+    UPROPERTY(BlueprintReadOnly)
+    int32 MaterializeCount = 0;
+
+    UPROPERTY(BlueprintReadOnly)
+    int32 EvictCount = 0;
+};
+
+USTRUCT(BlueprintType)
+struct PROCEDURALMESHUTILITY_API FPMUVoxelWeldStats
+{
+    GENERATED_BODY()
+
+    // Vertex count of all welded chunk sections
+    UPROPERTY(BlueprintReadOnly)
+    int32 InputVertexCount = 0;
+
+    // Vertex count after duplicate border vertices are welded
+    UPROPERTY(BlueprintReadOnly)
+    int32 OutputVertexCount = 0;
+
+    // Duplicate border vertices found across chunk borders
+    UPROPERTY(BlueprintReadOnly)
+    int32 WeldedVertexCount = 0;
+};
+
 struct FPMUVoxelSurfaceConfig
 {
     FVector2D Position;
@@ -101,6 +151,8 @@ struct FPMUVoxelSurfaceConfig
     float ExtrusionHeight;
     bool bGenerateExtrusion;
     bool bExtrusionSurface;
+    bool bMergeInteriorCells = false;
+    bool bDeferSimplification = false;
     FPMUMeshSimplifierOptions SimplifierOptions;
     FPMUVoxelGradientConfig GradientConfig;
     FPMUGridData* GridData = nullptr;
@@ -121,8 +173,14 @@ struct FPMUVoxelGridConfig
     float MaxFeatureAngle;
     float MaxParallelAngle;
     float ExtrusionHeight;
+    int32 TriangulationBands = 1;
+    bool bSignedDistance = false;
     FPMUGridData* GridData = nullptr;
 
+    // Background pool for deferred simplification, simplification
+    // runs synchronously on triangulation if not set
+    class FQueuedThreadPool* SimplifyThreadPool = nullptr;
+
 #ifdef PMU_VOXEL_USE_OCL
     class FOCLBProgram* GPUProgram = nullptr;
     FString GPUProgramKernelName;
@@ -183,6 +183,14 @@ struct PROCEDURALMESHUTILITY_API FPMUMeshSection
 		LocalBox.Init();
 	}
 
+	// Clear geometry but keep buffer capacity for reuse
+	void ResetGeometry()
+	{
+		VertexBuffer.Reset();
+		IndexBuffer.Reset();
+		LocalBox.Init();
+	}
+
 	void Shrink()
 	{
 		VertexBuffer.Shrink();
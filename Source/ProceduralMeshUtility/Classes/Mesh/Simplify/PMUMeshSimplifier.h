@@ -29,9 +29,18 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Mesh/PMUMeshTypes.h"
 #include "PMUMeshSimplifier.generated.h"
 
-struct FPMUMeshSection;
+UENUM(BlueprintType)
+enum class EPMUMeshSimplifierMethod : uint8
+{
+    // Parallel random edge fraction collapse passes
+    RandomEdgeCollapse,
+
+    // Greedy quadric error collapse ordered by a priority queue
+    QuadricPriorityQueue
+};
 
 USTRUCT(BlueprintType)
 struct FPMUMeshSimplifierOptions
@@ -42,6 +51,10 @@ struct FPMUMeshSimplifierOptions
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     bool bEnabled = false;
 
+	// Simplification backend
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    EPMUMeshSimplifierMethod Method = EPMUMeshSimplifierMethod::RandomEdgeCollapse;
+
 	// Each iteration involves selecting a fraction of the edges at random as possible 
 	// candidates for collapsing. There is likely a sweet spot here trading off against number 
 	// of edges processed vs number of invalid collapses generated due to collisions 
@@ -68,11 +81,103 @@ struct FPMUMeshSimplifierOptions
 	// If the mesh has sharp edges this can used to prevent collapses which would otherwise be used
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	float MinAngleCosine = 0.8f;
+
+	// Run collapse passes in parallel on large meshes. Parallel passes produce
+	// the same output as serial passes.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bParallelPasses = true;
+
+	// Simplify directly on the section vertex and index buffers instead of
+	// working copies. Lowers peak memory, triangle compaction runs serially.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bInPlace = false;
+
+	// Quadric backend only. Exact output triangle budget, collapses stop once the
+	// section is at or below this count. TargetPercentage is used if zero.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0"))
+	int32 TargetTriangleCount = 0;
+
+	// Quadric backend only. Maximum quadric error (summed squared plane distance)
+	// of a single collapse, no error budget if zero
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0"))
+	float MaxQuadricError = 0.f;
+};
+
+USTRUCT(BlueprintType)
+struct FPMUMeshCollapseRecord
+{
+    GENERATED_BODY();
+
+    // Surviving vertex of the collapse
+    UPROPERTY()
+    int32 KeepIndex = -1;
+
+    // Removed vertex, always the last live vertex of the sequence vertex buffer
+    UPROPERTY()
+    int32 RemoveIndex = -1;
+
+    // Surviving vertex attributes after the collapse
+    UPROPERTY()
+    FVector Position = FVector::ZeroVector;
+
+    UPROPERTY()
+    FVector Normal = FVector::ZeroVector;
+
+    // Live triangle count after the collapse
+    UPROPERTY()
+    int32 TriangleCount = 0;
+};
+
+// Progressive mesh of a section. Base buffers are ordered so that after any
+// number of collapses live vertices and triangles are buffer prefixes.
+USTRUCT(BlueprintType)
+struct FPMUMeshCollapseSequence
+{
+    GENERATED_BODY();
+
+    UPROPERTY()
+    TArray<FPMUMeshVertex> VertexBuffer;
+
+    UPROPERTY()
+    TArray<int32> IndexBuffer;
+
+    UPROPERTY()
+    TArray<FPMUMeshCollapseRecord> Collapses;
+
+    FORCEINLINE bool IsValid() const
+    {
+        return VertexBuffer.Num() > 0 && IndexBuffer.Num() > 0;
+    }
+
+    FORCEINLINE int32 GetMaxTriangleCount() const
+    {
+        return IndexBuffer.Num() / 3;
+    }
+
+    FORCEINLINE int32 GetMinTriangleCount() const
+    {
+        return Collapses.Num() > 0 ? Collapses.Last().TriangleCount : GetMaxTriangleCount();
+    }
+
+    void Empty()
+    {
+        VertexBuffer.Empty();
+        IndexBuffer.Empty();
+        Collapses.Empty();
+    }
+
+    // Minimum collapse count that reaches the target triangle count
+    int32 GetCollapseCount(int32 TargetTriangleCount) const;
+
+    // Replay collapses up to the target triangle count into the section
+    // vertex and index buffers. Cost is linear to the collapse count and
+    // output size, quadrics are not recomputed.
+    void GenerateSection(int32 TargetTriangleCount, FPMUMeshSection& OutSection) const;
 };
 
 class FPMUMeshSimplifier
 {
-    typedef struct FPMUMeshVertex FVertex;
+    typedef FPMUMeshVertex FVertex;
 
     struct FTri
     {
@@ -103,21 +208,142 @@ class FPMUMeshSimplifier
         struct { uint32_t min_, max_; };
     };
 
+    typedef TArrayView<FVertex> FVertexView;
+    typedef TArrayView<FTri> FTriView;
+
+    // Plane quadric stored as QEF normal equations (A = sum nn', b = sum (n.p)n)
+    // with the summed squared plane offset and mass point used by the QEF solver
+    struct FQuadric
+    {
+        double a00, a01, a02, a11, a12, a22;
+        double b0, b1, b2;
+        double c;
+        double px, py, pz;
+        double count;
+
+        void Reset();
+        void AddPlane(const FVector& n, const FVector& p);
+        void Add(const FQuadric& q);
+        double Evaluate(const FVector& x) const;
+        FVector Solve() const;
+    };
+
+    // Scratch arrays reused across simplifications, repeated simplifications
+    // with the same simplifier only allocate when a mesh outgrows them
+    struct FWorkspace
+    {
+        // Working copies, unused for in-place simplification
+        TArray<FVertex> vertices;
+        TArray<FTri> triangles;
+
+        TArray<FTri> triBuffer;
+        TArray<FEdge> edges;
+        TArray<FEdge> edgeBuffer;
+        TArray<int32> bucketOffsets;
+        TArray<bool> boundaryVerts;
+
+        TArray<FVector> collapsePosition;
+        TArray<FVector> collapseNormal;
+        TArray<int32> collapseValid;
+        TArray<int32> collapseEdgeID;
+        TArray<int32> collapseTarget;
+        TArray<int32> vertexTriangleCounts;
+
+        TArray<int32> randomEdges;
+        TArray<int64> minCollapseKey;
+        TArray<uint8> keepFlags;
+        TArray<int32> compactOffsets;
+        TArray<int32> vertexRemap;
+
+        // Quadric backend, vertex corner lists are ranges of vertexRefs
+        // holding implicit half-edge corners (tri*3 + corner)
+        TArray<FQuadric> quadrics;
+        TArray<int32> vertexRefStart;
+        TArray<int32> vertexRefCount;
+        TArray<int32> vertexRefs;
+        TArray<uint8> vertexLocked;
+        TArray<uint32> vertexMarks;
+        TArray<uint8> triRemoved;
+        TArray<int32> heap;
+        TArray<int32> heapIndex;
+        TArray<double> collapseCost;
+
+        // Collapse sequence recording
+        TArray<int32> triCollapseStep;
+        TArray<FPMUMeshCollapseRecord> collapseRecords;
+
+        void Empty();
+    };
+
     static const int32 COLLAPSE_MAX_DEGREE = 16;
     static const int32 MAX_TRIANGLES_PER_VERTEX = COLLAPSE_MAX_DEGREE;
 
+    // Minimum triangle count for parallel collapse passes
+    static const int32 PARALLEL_MIN_TRIANGLES = 8192;
+
+    // Workspace to last input triangle count ratio that trims the workspace
+    static const int32 WORKSPACE_TRIM_RATIO = 4;
+
     FPMUMeshSimplifierOptions Options;
+    FWorkspace Workspace;
+
+    // Largest input triangle count since the workspace was last emptied
+    int32 workspaceTriangleCount = 0;
+
+    // Triangle count of the last input
+    int32 lastTriangleCount = 0;
+
+    // Whether the current simplification runs parallel passes
+    bool bParallel = false;
+
+    // Stamp of the current vertex mark pass
+    uint32 markStamp = 0;
+
+    // Whether quadric collapses are recorded to the workspace
+    bool bRecordCollapses = false;
+
+    void SimplifyEdgeCollapse(FVertexView& vertices, FTriView& triangles);
+
+    void SimplifyQuadric(FVertexView& vertices, FTriView& triangles);
+
+    void BuildQuadricConnectivity(const FVertexView& vertices, const FTriView& triangles);
+
+    bool EvaluateQuadricCollapse(
+        const FVertexView& vertices,
+        const FTriView& triangles,
+        int32 v0,
+        int32 v1,
+        double& outCost,
+        FVector& outPosition
+        );
+
+    void UpdateQuadricCollapse(
+        const FVertexView& vertices,
+        const FTriView& triangles,
+        int32 v
+        );
+
+    int32 CollapseQuadricEdge(
+        FVertexView& vertices,
+        FTriView& triangles,
+        int32 v0,
+        int32 v1,
+        const FVector& position
+        );
+
+    uint32 NextMarkStamp();
+
+    void SortEdges(TArray<FEdge>& edges, const int32 vertexCount);
 
     void BuildCandidateEdges(
-        const TArray<FVertex>& vertices,
-        const TArray<FTri>& triangles,
+        const FVertexView& vertices,
+        const FTriView& triangles,
         TArray<FEdge>& edges
         );
 
     int32 FindValidCollapses(
         const TArray<FEdge>& edges,
-        const TArray<FVertex>& vertices,
-        const TArray<FTri>& tris,
+        const FVertexView& vertices,
         const TArray<int32>& vertexTriangleCounts,
         TArray<int32>& collapseValid, 
         TArray<int32>& collapseEdgeID, 
@@ -131,15 +357,13 @@ class FPMUMeshSimplifier
         const TArray<int32>& collapseEdgeID,
         const TArray<FVector>& collapsePositions,
         const TArray<FVector>& collapseNormal,
-        TArray<FVertex>& vertices,
+        FVertexView& vertices,
         TArray<int32>& collapseTarget
         );
 
     int32 RemoveTriangles(
-        const TArray<FVertex>& vertices,
         const TArray<int32>& collapseTarget,
-        TArray<FTri>& tris,
-        TArray<FTri>& triBuffer,
+        FTriView& tris,
         TArray<int32>& vertexTriangleCounts
         );
 
@@ -149,9 +373,9 @@ class FPMUMeshSimplifier
         TArray<FEdge>& edgeBuffer
         );
 
-    void CompactVertices(
-        TArray<FVertex>& vertices,
-        TArray<FTri>& triangles
+    int32 CompactVertices(
+        FVertexView& vertices,
+        FTriView& triangles
         );
 
 public:
@@ -161,4 +385,29 @@ public:
         const FVector& InWorldOffset,
         const FPMUMeshSimplifierOptions& InOptions
         );
+
+    // Record the complete quadric collapse sequence of a section for progressive
+    // LOD. Target triangle counts are ignored, collapses run until no valid
+    // collapse remains or MaxQuadricError is exceeded.
+    void BuildCollapseSequence(
+        const FPMUMeshSection& mesh,
+        const FPMUMeshSimplifierOptions& InOptions,
+        FPMUMeshCollapseSequence& OutSequence
+        );
+
+    // Release workspace allocations
+    void EmptyWorkspace()
+    {
+        Workspace.Empty();
+        workspaceTriangleCount = 0;
+    }
+
+    // Release workspace allocations if the workspace was sized for an input
+    // several times larger than the last one. Called after thread simplifier
+    // use so threads do not keep scratch sized for their largest input.
+    void TrimWorkspace();
+
+    // Simplifier owned by the calling thread, reusing its workspace
+    // across every section simplified on that thread
+    static FPMUMeshSimplifier& GetThreadSimplifier();
 };
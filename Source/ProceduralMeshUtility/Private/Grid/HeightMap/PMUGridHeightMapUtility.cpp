@@ -88,7 +88,7 @@ void UPMUGridHeightMapUtility::GetHeightNormal(const float X, const float Y, con
         {
             check((IX+1) < Dim.X);
 
-            float hv = GetLerpX(Y, IX, IY, Stride, HeightMap);
+            float hv = GetLerpX(X, IX, IY, Stride, HeightMap);
             float hW = (IX > 0)         ? GetLerpX(X-1.f, IX-1, IY,   Stride, HeightMap) : hv;
             float hN = (IY > 0)         ? GetLerpX(X,     IX,   IY-1, Stride, HeightMap) : hv;
             float hE = ((IX+1) < Dim.X) ? GetLerpX(X+1.f, IX+1, IY,   Stride, HeightMap) : hv;
@@ -35,50 +35,64 @@ class FPMUVoxelCell
 {
 public:
 
-    FPMUVoxel a;
-    FPMUVoxel b;
-    FPMUVoxel c;
-    FPMUVoxel d;
+    // Cell corners reference voxels owned by the caller, gathered
+    // voxels are stored in the cell itself
+
+    const FPMUVoxel* a = nullptr;
+    const FPMUVoxel* b = nullptr;
+    const FPMUVoxel* c = nullptr;
+    const FPMUVoxel* d = nullptr;
+
+    FPMUVoxel gathered[4];
     
     int32 i;
     
     float sharpFeatureLimit;
     float parallelLimit;
 
+    FORCEINLINE void Set(int32 inI, const FPMUVoxel& inA, const FPMUVoxel& inB, const FPMUVoxel& inC, const FPMUVoxel& inD)
+    {
+        i = inI;
+        a = &inA;
+        b = &inB;
+        c = &inC;
+        d = &inD;
+    }
+
     FORCEINLINE FVector2D GetAverageNESW() const
     {
-        return (a.GetXEdgePoint() + a.GetYEdgePoint() +
-                b.GetYEdgePoint() + c.GetXEdgePoint()) * 0.25f;
+        return (a->GetXEdgePoint() + a->GetYEdgePoint() +
+                b->GetYEdgePoint() + c->GetXEdgePoint()) * 0.25f;
     }
 
     FORCEINLINE FPMUVoxelFeaturePoint GetFeatureSW() const
     {
-        return GetSharpFeature(a.GetXEdgePoint(), a.xNormal, a.GetYEdgePoint(), a.yNormal);
+        return GetSharpFeature(a->GetXEdgePoint(), a->xNormal, a->GetYEdgePoint(), a->yNormal);
     }
     
     FORCEINLINE FPMUVoxelFeaturePoint GetFeatureSE() const
     {
-        return GetSharpFeature(a.GetXEdgePoint(), a.xNormal, b.GetYEdgePoint(), b.yNormal);
+        return GetSharpFeature(a->GetXEdgePoint(), a->xNormal, b->GetYEdgePoint(), b->yNormal);
     }
     
     FORCEINLINE FPMUVoxelFeaturePoint GetFeatureNW() const
     {
-        return GetSharpFeature(a.GetYEdgePoint(), a.yNormal, c.GetXEdgePoint(), c.xNormal);
+        return GetSharpFeature(a->GetYEdgePoint(), a->yNormal, c->GetXEdgePoint(), c->xNormal);
     }
     
     FORCEINLINE FPMUVoxelFeaturePoint GetFeatureNE() const
     {
-        return GetSharpFeature(c.GetXEdgePoint(), c.xNormal, b.GetYEdgePoint(), b.yNormal);
+        return GetSharpFeature(c->GetXEdgePoint(), c->xNormal, b->GetYEdgePoint(), b->yNormal);
     }
     
     FORCEINLINE FPMUVoxelFeaturePoint GetFeatureNS() const
     {
-        return GetSharpFeature(a.GetXEdgePoint(), a.xNormal, c.GetXEdgePoint(), c.xNormal);
+        return GetSharpFeature(a->GetXEdgePoint(), a->xNormal, c->GetXEdgePoint(), c->xNormal);
     }
     
     FORCEINLINE FPMUVoxelFeaturePoint GetFeatureEW() const
     {
-        return GetSharpFeature(a.GetYEdgePoint(), a.yNormal, b.GetYEdgePoint(), b.yNormal);
+        return GetSharpFeature(a->GetYEdgePoint(), a->yNormal, b->GetYEdgePoint(), b->yNormal);
     }
 
     FORCEINLINE FPMUVoxelFeaturePoint GetFeatureNEW() const
@@ -87,7 +101,7 @@ public:
             GetFeatureEW(), GetFeatureNE(), GetFeatureNW());
         if (!f.exists)
         {
-            f.position = (a.GetYEdgePoint() + b.GetYEdgePoint() + c.GetXEdgePoint()) / 3.f;
+            f.position = (a->GetYEdgePoint() + b->GetYEdgePoint() + c->GetXEdgePoint()) / 3.f;
             f.exists = true;
         }
         return f;
@@ -99,7 +113,7 @@ public:
             GetFeatureNS(), GetFeatureSE(), GetFeatureNE());
         if (!f.exists)
         {
-            f.position = (a.GetXEdgePoint() + b.GetYEdgePoint() + c.GetXEdgePoint()) / 3.f;
+            f.position = (a->GetXEdgePoint() + b->GetYEdgePoint() + c->GetXEdgePoint()) / 3.f;
             f.exists = true;
         }
         return f;
@@ -111,7 +125,7 @@ public:
             GetFeatureNS(), GetFeatureNW(), GetFeatureSW());
         if (!f.exists)
         {
-            f.position = (a.GetXEdgePoint() + a.GetYEdgePoint() + c.GetXEdgePoint()) / 3.f;
+            f.position = (a->GetXEdgePoint() + a->GetYEdgePoint() + c->GetXEdgePoint()) / 3.f;
             f.exists = true;
         }
         return f;
@@ -123,7 +137,7 @@ public:
             GetFeatureEW(), GetFeatureSE(), GetFeatureSW());
         if (!f.exists)
         {
-            f.position = (a.GetXEdgePoint() + a.GetYEdgePoint() + b.GetYEdgePoint()) / 3.f;
+            f.position = (a->GetXEdgePoint() + a->GetYEdgePoint() + b->GetYEdgePoint()) / 3.f;
             f.exists = true;
         }
         return f;
@@ -131,9 +145,9 @@ public:
 
     bool HasConnectionAD(const FPMUVoxelFeaturePoint& fA, const FPMUVoxelFeaturePoint& fD)
     {
-        bool flip = (a.state < b.state) == (a.state < c.state);
-        if (IsParallel(a.xNormal, a.yNormal, flip) ||
-            IsParallel(c.xNormal, b.yNormal, flip))
+        bool flip = (a->state < b->state) == (a->state < c->state);
+        if (IsParallel(a->xNormal, a->yNormal, flip) ||
+            IsParallel(c->xNormal, b->yNormal, flip))
         {
             return true;
         }
@@ -141,33 +155,33 @@ public:
         {
             if (fD.exists)
             {
-                if (IsBelowLine(fA.position, b.GetYEdgePoint(), fD.position))
+                if (IsBelowLine(fA.position, b->GetYEdgePoint(), fD.position))
                 {
-                    if (IsBelowLine(fA.position, fD.position, c.GetXEdgePoint()) ||
-                        IsBelowLine(fD.position, fA.position, a.GetXEdgePoint()))
+                    if (IsBelowLine(fA.position, fD.position, c->GetXEdgePoint()) ||
+                        IsBelowLine(fD.position, fA.position, a->GetXEdgePoint()))
                     {
                         return true;
                     }
                 }
-                else if (IsBelowLine(fA.position, fD.position, c.GetXEdgePoint()) &&
-                         IsBelowLine(fD.position, a.GetYEdgePoint(), fA.position))
+                else if (IsBelowLine(fA.position, fD.position, c->GetXEdgePoint()) &&
+                         IsBelowLine(fD.position, a->GetYEdgePoint(), fA.position))
                 {
                     return true;
                 }
                 return false;
             }
-            return IsBelowLine(fA.position, b.GetYEdgePoint(), c.GetXEdgePoint());
+            return IsBelowLine(fA.position, b->GetYEdgePoint(), c->GetXEdgePoint());
         }
         return fD.exists &&
-            IsBelowLine(fD.position, a.GetYEdgePoint(), a.GetXEdgePoint());
+            IsBelowLine(fD.position, a->GetYEdgePoint(), a->GetXEdgePoint());
     }
     
     bool HasConnectionBC(const FPMUVoxelFeaturePoint& fB, const FPMUVoxelFeaturePoint& fC)
     {
-        bool flip = (b.state < a.state) == (b.state < d.state);
+        bool flip = (b->state < a->state) == (b->state < d->state);
         if (
-            IsParallel(a.xNormal, b.yNormal, flip) ||
-            IsParallel(c.xNormal, a.yNormal, flip))
+            IsParallel(a->xNormal, b->yNormal, flip) ||
+            IsParallel(c->xNormal, a->yNormal, flip))
         {
             return true;
         }
@@ -175,45 +189,45 @@ public:
         {
             if (fC.exists)
             {
-                if (IsBelowLine(fC.position, a.GetXEdgePoint(), fB.position))
+                if (IsBelowLine(fC.position, a->GetXEdgePoint(), fB.position))
                 {
-                    if (IsBelowLine(fC.position, fB.position, b.GetYEdgePoint()) ||
-                        IsBelowLine(fB.position, fC.position, a.GetYEdgePoint()))
+                    if (IsBelowLine(fC.position, fB.position, b->GetYEdgePoint()) ||
+                        IsBelowLine(fB.position, fC.position, a->GetYEdgePoint()))
                     {
                         return true;
                     }
                 }
-                else if (IsBelowLine(fC.position, fB.position, b.GetYEdgePoint()) &&
-                         IsBelowLine(fB.position, c.GetXEdgePoint(), fC.position))
+                else if (IsBelowLine(fC.position, fB.position, b->GetYEdgePoint()) &&
+                         IsBelowLine(fB.position, c->GetXEdgePoint(), fC.position))
                 {
                     return true;
                 }
                 return false;
             }
-            return IsBelowLine(fB.position, c.GetXEdgePoint(), a.GetYEdgePoint());
+            return IsBelowLine(fB.position, c->GetXEdgePoint(), a->GetYEdgePoint());
         }
         return fC.exists &&
-            IsBelowLine(fC.position, a.GetXEdgePoint(), b.GetYEdgePoint());
+            IsBelowLine(fC.position, a->GetXEdgePoint(), b->GetYEdgePoint());
     }
 
     FORCEINLINE bool IsInsideABD(const FVector2D& point)
     {
-        return IsBelowLine(point, a.position, d.position);
+        return IsBelowLine(point, a->position, d->position);
     }
     
     FORCEINLINE bool IsInsideACD(const FVector2D& point)
     {
-        return IsBelowLine(point, d.position, a.position);
+        return IsBelowLine(point, d->position, a->position);
     }
 
     FORCEINLINE bool IsInsideABC(const FVector2D& point)
     {
-        return IsBelowLine(point, c.position, b.position);
+        return IsBelowLine(point, c->position, b->position);
     }
 
     FORCEINLINE bool IsInsideBCD(const FVector2D& point)
     {
-        return IsBelowLine(point, b.position, c.position);
+        return IsBelowLine(point, b->position, c->position);
     }
 
 private:
@@ -236,38 +250,38 @@ private:
 
     FORCEINLINE FPMUVoxelFeaturePoint GetCheckedFeatureSW() const
     {
-        FVector2D n2 = (a.state < b.state) == (a.state < c.state) ?  a.yNormal : -a.yNormal;
-        return GetSharpFeature(a.GetXEdgePoint(), a.xNormal, a.GetYEdgePoint(), n2);
+        FVector2D n2 = (a->state < b->state) == (a->state < c->state) ?  a->yNormal : -a->yNormal;
+        return GetSharpFeature(a->GetXEdgePoint(), a->xNormal, a->GetYEdgePoint(), n2);
     }
     
     FORCEINLINE FPMUVoxelFeaturePoint GetCheckedFeatureSE() const
     {
-        FVector2D n2 = (b.state < a.state) == (b.state < c.state) ?  b.yNormal : -b.yNormal;
-        return GetSharpFeature(a.GetXEdgePoint(), a.xNormal, b.GetYEdgePoint(), n2);
+        FVector2D n2 = (b->state < a->state) == (b->state < c->state) ?  b->yNormal : -b->yNormal;
+        return GetSharpFeature(a->GetXEdgePoint(), a->xNormal, b->GetYEdgePoint(), n2);
     }
     
     FORCEINLINE FPMUVoxelFeaturePoint GetCheckedFeatureNW() const
     {
-        FVector2D n2 = (c.state < a.state) == (c.state < d.state) ?  c.xNormal : -c.xNormal;
-        return GetSharpFeature(a.GetYEdgePoint(), a.yNormal, c.GetXEdgePoint(), n2);
+        FVector2D n2 = (c->state < a->state) == (c->state < d->state) ?  c->xNormal : -c->xNormal;
+        return GetSharpFeature(a->GetYEdgePoint(), a->yNormal, c->GetXEdgePoint(), n2);
     }
     
     FORCEINLINE FPMUVoxelFeaturePoint GetCheckedFeatureNE() const
     {
-        FVector2D n2 = (d.state < b.state) == (d.state < c.state) ?  b.yNormal : -b.yNormal;
-        return GetSharpFeature(c.GetXEdgePoint(), c.xNormal, b.GetYEdgePoint(), n2);
+        FVector2D n2 = (d->state < b->state) == (d->state < c->state) ?  b->yNormal : -b->yNormal;
+        return GetSharpFeature(c->GetXEdgePoint(), c->xNormal, b->GetYEdgePoint(), n2);
     }
     
     FORCEINLINE FPMUVoxelFeaturePoint GetCheckedFeatureNS() const
     {
-        FVector2D n2 = (a.state < b.state) == (c.state < d.state) ?  c.xNormal : -c.xNormal;
-        return GetSharpFeature(a.GetXEdgePoint(), a.xNormal, c.GetXEdgePoint(), n2);
+        FVector2D n2 = (a->state < b->state) == (c->state < d->state) ?  c->xNormal : -c->xNormal;
+        return GetSharpFeature(a->GetXEdgePoint(), a->xNormal, c->GetXEdgePoint(), n2);
     }
     
     FORCEINLINE FPMUVoxelFeaturePoint GetCheckedFeatureEW() const
     {
-        FVector2D n2 = (a.state < c.state) == (b.state < d.state) ?  b.yNormal : -b.yNormal;
-        return GetSharpFeature(a.GetYEdgePoint(), a.yNormal, b.GetYEdgePoint(), n2);
+        FVector2D n2 = (a->state < c->state) == (b->state < d->state) ?  b->yNormal : -b->yNormal;
+        return GetSharpFeature(a->GetYEdgePoint(), a->yNormal, b->GetYEdgePoint(), n2);
     }
 
     FPMUVoxelFeaturePoint GetSharpFeature(const FVector2D& p1, const FVector2D& n1, const FVector2D& p2, const FVector2D& n2) const
@@ -300,7 +314,7 @@ private:
     FORCEINLINE bool IsInsideCell(const FVector2D& point) const
     {
         return
-            point.X > a.position.X && point.Y > a.position.Y &&
-            point.X < d.position.X && point.Y < d.position.Y;
+            point.X > a->position.X && point.Y > a->position.Y &&
+            point.X < d->position.X && point.Y < d->position.Y;
     }
 };
@@ -0,0 +1,784 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+#include "PMUVoxel.h"
+
+// Struct-of-arrays voxel storage.
+//
+// Voxel position is implicit and derived from voxel coordinate, states are
+// kept separate from edge crossing data so that triangulation passes that
+// only inspect states stay within a compact contiguous array.
+//
+// Per-state voxel counts are maintained alongside states so that empty
+// and uniformly filled chunks can be identified without a voxel scan.
+//
+// Storage is quantized, 9 bytes per voxel instead of 28. States are 8-bit,
+// edge crossings are 16-bit offsets from the edge start voxel (zero for no
+// crossing) and crossing normals are 16-bit angles. Voxel data is decoded
+// on access into FPMUVoxel and encoded back on write. The same planes are
+// used by the compact serialization.
+//
+// Signed distance voxel data replaces the crossing planes with a single
+// 16-bit distance plane, 3 bytes per voxel. A voxel distance is measured
+// to the border of the voxel state region, distance sign is given by the
+// voxel state. Crossings and normals are derived from neighbouring voxel
+// distances on access instead of being written by stencils.
+
+struct FPMUVoxelData
+{
+    // Maximum number of voxel states, including the empty state
+    enum { MaxStateCount = 256 };
+
+    // Distances are clamped to the number of voxels from a state border
+    enum { DistanceRange = 2 };
+
+    // Upper bound of loaded voxel resolution, guards allocation on load
+    enum { MaxVoxelResolution = 4096 };
+
+    // Compact serialization versions
+    enum
+    {
+        VersionLegacyCrossings = 1,
+        VersionQuantizedCrossings = 2,
+        VersionDistances = 3,
+        VersionLatest = VersionDistances
+    };
+
+    int32 voxelResolution = 0;
+    float voxelSize = 1.f;
+
+    // Coordinate of the first voxel. Defaults to half voxel size,
+    // downsampled LOD data keeps the offset of its source voxels.
+    float voxelOffset = .5f;
+
+    TArray<uint8> states;
+    TArray<int32> stateCounts;
+
+    TArray<uint16> xEdges;
+    TArray<uint16> yEdges;
+
+    TArray<uint16> xNormals;
+    TArray<uint16> yNormals;
+
+    // Signed distance voxel data only, crossing planes are left empty
+    TArray<uint16> distances;
+
+    void Initialize(int32 inVoxelResolution, float inVoxelSize, bool bSignedDistance = false)
+    {
+        voxelResolution = inVoxelResolution;
+        voxelSize = inVoxelSize;
+        voxelOffset = voxelSize * .5f;
+
+        const int32 voxelCount = voxelResolution * voxelResolution;
+        const int32 crossingCount = bSignedDistance ? 0 : voxelCount;
+
+        states.SetNumZeroed(voxelCount);
+        xEdges.SetNumZeroed(crossingCount);
+        yEdges.SetNumZeroed(crossingCount);
+        xNormals.SetNumZeroed(crossingCount);
+        yNormals.SetNumZeroed(crossingCount);
+        distances.SetNumZeroed(voxelCount - crossingCount);
+
+        Reset();
+    }
+
+    void Reset()
+    {
+        const int32 voxelCount = Num();
+
+        FMemory::Memzero(states.GetData(), voxelCount * states.GetTypeSize());
+        FMemory::Memzero(xEdges.GetData(), xEdges.Num() * xEdges.GetTypeSize());
+        FMemory::Memzero(yEdges.GetData(), yEdges.Num() * yEdges.GetTypeSize());
+
+        // Reset voxels are considered far from any state border
+        FMemory::Memset(distances.GetData(), 0xFF, distances.Num() * distances.GetTypeSize());
+
+        stateCounts.Reset();
+        stateCounts.Emplace(voxelCount);
+    }
+
+    FORCEINLINE bool HasDistances() const
+    {
+        return distances.Num() > 0;
+    }
+
+    FORCEINLINE int32 Num() const
+    {
+        return states.Num();
+    }
+
+    FORCEINLINE bool IsValidIndex(int32 i) const
+    {
+        return states.IsValidIndex(i);
+    }
+
+    // State histogram
+
+    FORCEINLINE void SetState(int32 i, int32 state)
+    {
+        checkSlow(state >= 0 && state < MaxStateCount);
+
+        const int32 prevState = states[i];
+
+        if (prevState != state)
+        {
+            if (! stateCounts.IsValidIndex(state))
+            {
+                stateCounts.SetNumZeroed(state + 1);
+            }
+
+            --stateCounts[prevState];
+            ++stateCounts[state];
+            states[i] = static_cast<uint8>(state);
+        }
+    }
+
+    FORCEINLINE int32 GetStateCount(int32 state) const
+    {
+        return stateCounts.IsValidIndex(state) ? stateCounts[state] : 0;
+    }
+
+    // Returns the state shared by every voxel or INDEX_NONE if voxel
+    // states are mixed. Empty chunks return zero state.
+    FORCEINLINE int32 GetUniformState() const
+    {
+        const int32 voxelCount = Num();
+
+        if (voxelCount > 0 && GetStateCount(states[0]) == voxelCount)
+        {
+            return states[0];
+        }
+
+        return INDEX_NONE;
+    }
+
+    void RebuildStateCounts()
+    {
+        stateCounts.Reset();
+
+        for (int32 state : states)
+        {
+            if (! stateCounts.IsValidIndex(state))
+            {
+                stateCounts.SetNumZeroed(state + 1);
+            }
+
+            ++stateCounts[state];
+        }
+    }
+
+    FORCEINLINE int32 GetIndex(int32 x, int32 y) const
+    {
+        return y * voxelResolution + x;
+    }
+
+    FORCEINLINE float GetCoordinate(int32 x) const
+    {
+        return x * voxelSize + voxelOffset;
+    }
+
+    FORCEINLINE FVector2D GetPosition(int32 x, int32 y) const
+    {
+        return FVector2D(GetCoordinate(x), GetCoordinate(y));
+    }
+
+    FORCEINLINE FVector2D GetPosition(int32 i) const
+    {
+        return GetPosition(i % voxelResolution, i / voxelResolution);
+    }
+
+    // Edge point queries are only valid for edges within voxel data,
+    // edges between chunks are resolved by the owning grid
+
+    FORCEINLINE FVector2D GetXEdgePoint(int32 x, int32 y) const
+    {
+        const int32 i = GetIndex(x, y);
+        const float coordinate = GetCoordinate(x);
+        const float edge = HasDistances()
+            ? coordinate + GetCrossingAlpha(GetDistance(i), GetDistance(i+1)) * voxelSize
+            : DecodeEdge(xEdges[i], coordinate);
+        return FVector2D(edge, GetCoordinate(y));
+    }
+
+    FORCEINLINE FVector2D GetYEdgePoint(int32 x, int32 y) const
+    {
+        const int32 i = GetIndex(x, y);
+        const float coordinate = GetCoordinate(y);
+        const float edge = HasDistances()
+            ? coordinate + GetCrossingAlpha(GetDistance(i), GetDistance(i+voxelResolution)) * voxelSize
+            : DecodeEdge(yEdges[i], coordinate);
+        return FVector2D(GetCoordinate(x), edge);
+    }
+
+    // Distance quantization
+
+    FORCEINLINE float GetDistance(int32 i) const
+    {
+        // Voxel data without distances places state borders at edge midpoints
+        return HasDistances()
+            ? distances[i] * (voxelSize * DistanceRange / 65535.f)
+            : voxelSize * .5f;
+    }
+
+    FORCEINLINE void SetDistance(int32 i, float distance)
+    {
+        const float t = FMath::Clamp(distance / (voxelSize * DistanceRange), 0.f, 1.f);
+        distances[i] = static_cast<uint16>(FMath::RoundToInt(t * 65535.f));
+    }
+
+    // Returns crossing offset from the first voxel in fraction of voxel size
+    FORCEINLINE static float GetCrossingAlpha(float distance0, float distance1)
+    {
+        const float distanceSum = distance0 + distance1;
+        return (distanceSum > KINDA_SMALL_NUMBER) ? (distance0 / distanceSum) : .5f;
+    }
+
+    // Distance field relative to the specified state, negative inside
+    FORCEINLINE float GetStateDistance(int32 x, int32 y, int32 state) const
+    {
+        const int32 i = GetIndex(x, y);
+        const float distance = GetDistance(i);
+        return (states[i] == state) ? -distance : distance;
+    }
+
+    // Derive x edge crossing between voxel (x, y) and voxel (xMax, y)
+    // of xMaxData, which is either this voxel data or x neighbour data.
+    // Crossing normal is the distance gradient relative to the higher
+    // edge state so that it points towards the lower state.
+
+    void DeriveXCrossing(int32 x, int32 y, const FPMUVoxelData& xMaxData, int32 xMax, FPMUVoxel& voxel) const
+    {
+        const int32 i = GetIndex(x, y);
+        const int32 state = states[i];
+        const int32 maxState = xMaxData.states[xMaxData.GetIndex(xMax, y)];
+
+        if (state == maxState)
+        {
+            voxel.xEdge = TNumericLimits<float>::Lowest();
+            return;
+        }
+
+        const int32 highState = FMath::Max(state, maxState);
+        const float d0 = GetStateDistance(x, y, highState);
+        const float d1 = xMaxData.GetStateDistance(xMax, y, highState);
+        const int32 y0 = FMath::Max(y-1, 0);
+        const int32 y1 = FMath::Min(y+1, voxelResolution-1);
+
+        const FVector2D gradient(
+            d1 - d0,
+            (GetStateDistance(x, y1, highState) - GetStateDistance(x, y0, highState) +
+             xMaxData.GetStateDistance(xMax, y1, highState) - xMaxData.GetStateDistance(xMax, y0, highState))
+                / (2 * FMath::Max(y1-y0, 1))
+            );
+
+        voxel.xEdge = GetCoordinate(x) + GetCrossingAlpha(FMath::Abs(d0), FMath::Abs(d1)) * voxelSize;
+        voxel.xNormal = gradient.GetSafeNormal();
+
+        if (voxel.xNormal.IsZero())
+        {
+            voxel.xNormal = FVector2D(state == highState ? 1.f : -1.f, 0.f);
+        }
+    }
+
+    // Derive y edge crossing between voxel (x, y) and voxel (x, yMax)
+    // of yMaxData, which is either this voxel data or y neighbour data
+
+    void DeriveYCrossing(int32 x, int32 y, const FPMUVoxelData& yMaxData, int32 yMax, FPMUVoxel& voxel) const
+    {
+        const int32 i = GetIndex(x, y);
+        const int32 state = states[i];
+        const int32 maxState = yMaxData.states[yMaxData.GetIndex(x, yMax)];
+
+        if (state == maxState)
+        {
+            voxel.yEdge = TNumericLimits<float>::Lowest();
+            return;
+        }
+
+        const int32 highState = FMath::Max(state, maxState);
+        const float d0 = GetStateDistance(x, y, highState);
+        const float d1 = yMaxData.GetStateDistance(x, yMax, highState);
+        const int32 x0 = FMath::Max(x-1, 0);
+        const int32 x1 = FMath::Min(x+1, voxelResolution-1);
+
+        const FVector2D gradient(
+            (GetStateDistance(x1, y, highState) - GetStateDistance(x0, y, highState) +
+             yMaxData.GetStateDistance(x1, yMax, highState) - yMaxData.GetStateDistance(x0, yMax, highState))
+                / (2 * FMath::Max(x1-x0, 1)),
+            d1 - d0
+            );
+
+        voxel.yEdge = GetCoordinate(y) + GetCrossingAlpha(FMath::Abs(d0), FMath::Abs(d1)) * voxelSize;
+        voxel.yNormal = gradient.GetSafeNormal();
+
+        if (voxel.yNormal.IsZero())
+        {
+            voxel.yNormal = FVector2D(0.f, state == highState ? 1.f : -1.f);
+        }
+    }
+
+    // Crossing quantization
+
+    FORCEINLINE uint16 EncodeEdge(float edge, float coordinate) const
+    {
+        if (edge == TNumericLimits<float>::Lowest())
+        {
+            return 0;
+        }
+
+        const float t = FMath::Clamp((edge - coordinate) / voxelSize, 0.f, 1.f);
+        return static_cast<uint16>(1 + FMath::RoundToInt(t * 65534.f));
+    }
+
+    FORCEINLINE float DecodeEdge(uint16 edge, float coordinate) const
+    {
+        return (edge > 0)
+            ? coordinate + (edge - 1) * (voxelSize / 65534.f)
+            : TNumericLimits<float>::Lowest();
+    }
+
+    FORCEINLINE static uint16 EncodeNormal(const FVector2D& normal)
+    {
+        const float angle = FMath::Atan2(normal.Y, normal.X);
+        return static_cast<uint16>(FMath::RoundToInt(angle * (65536.f / (2.f * PI))) & 0xFFFF);
+    }
+
+    FORCEINLINE static FVector2D DecodeNormal(uint16 normal)
+    {
+        float S, C;
+        FMath::SinCos(&S, &C, normal * ((2.f * PI) / 65536.f));
+        return FVector2D(C, S);
+    }
+
+    // Gather voxel data into a voxel struct
+
+    FORCEINLINE void GetVoxel(int32 x, int32 y, FPMUVoxel& voxel) const
+    {
+        const int32 i = GetIndex(x, y);
+        voxel.state = states[i];
+        voxel.position = GetPosition(x, y);
+
+        if (HasDistances())
+        {
+            voxel.xEdge = TNumericLimits<float>::Lowest();
+            voxel.yEdge = TNumericLimits<float>::Lowest();
+
+            if (x+1 < voxelResolution)
+            {
+                DeriveXCrossing(x, y, *this, x+1, voxel);
+            }
+
+            if (y+1 < voxelResolution)
+            {
+                DeriveYCrossing(x, y, *this, y+1, voxel);
+            }
+
+            return;
+        }
+
+        voxel.xEdge = DecodeEdge(xEdges[i], voxel.position.X);
+        voxel.yEdge = DecodeEdge(yEdges[i], voxel.position.Y);
+        voxel.xNormal = DecodeNormal(xNormals[i]);
+        voxel.yNormal = DecodeNormal(yNormals[i]);
+    }
+
+    FORCEINLINE void GetVoxel(int32 i, FPMUVoxel& voxel) const
+    {
+        GetVoxel(i % voxelResolution, i / voxelResolution, voxel);
+    }
+
+    // Gather voxel state and position only, crossings are left empty.
+    // Used on neighbour voxels whose crossing planes may be written
+    // by a concurrent edit of the neighbour chunk.
+
+    FORCEINLINE void GetVoxelState(int32 x, int32 y, FPMUVoxel& voxel) const
+    {
+        voxel.state = states[GetIndex(x, y)];
+        voxel.position = GetPosition(x, y);
+        voxel.xEdge = TNumericLimits<float>::Lowest();
+        voxel.yEdge = TNumericLimits<float>::Lowest();
+        voxel.xNormal = FVector2D::ZeroVector;
+        voxel.yNormal = FVector2D::ZeroVector;
+    }
+
+    // Scatter voxel crossing data back into storage
+
+    FORCEINLINE void SetCrossings(int32 i, const FPMUVoxel& voxel)
+    {
+        checkSlow(! HasDistances());
+
+        const FVector2D position(GetPosition(i));
+        xEdges[i] = EncodeEdge(voxel.xEdge, position.X);
+        yEdges[i] = EncodeEdge(voxel.yEdge, position.Y);
+        xNormals[i] = EncodeNormal(voxel.xNormal);
+        yNormals[i] = EncodeNormal(voxel.yNormal);
+    }
+
+    // Replace crossing planes with distances to the nearest crossing
+    // of each voxel, used to convert voxel data without distances
+
+    void ConvertCrossingsToDistances()
+    {
+        if (HasDistances())
+        {
+            return;
+        }
+
+        const int32 voxelCount = Num();
+        const float Lowest = TNumericLimits<float>::Lowest();
+
+        distances.SetNumUninitialized(voxelCount);
+        FMemory::Memset(distances.GetData(), 0xFF, voxelCount * distances.GetTypeSize());
+
+        auto UpdateDistance = [&](int32 i, float distance)
+        {
+            if (distance < GetDistance(i))
+            {
+                SetDistance(i, distance);
+            }
+        };
+
+        for (int32 y=0, i=0; y<voxelResolution; ++y)
+        for (int32 x=0; x<voxelResolution; ++x, ++i)
+        {
+            const FVector2D position(GetPosition(x, y));
+            const float xEdge = DecodeEdge(xEdges[i], position.X);
+            const float yEdge = DecodeEdge(yEdges[i], position.Y);
+
+            if (xEdge != Lowest)
+            {
+                UpdateDistance(i, xEdge - position.X);
+
+                if (x+1 < voxelResolution)
+                {
+                    UpdateDistance(i+1, position.X + voxelSize - xEdge);
+                }
+            }
+
+            if (yEdge != Lowest)
+            {
+                UpdateDistance(i, yEdge - position.Y);
+
+                if (y+1 < voxelResolution)
+                {
+                    UpdateDistance(i+voxelResolution, position.Y + voxelSize - yEdge);
+                }
+            }
+        }
+
+        xEdges.Empty();
+        yEdges.Empty();
+        xNormals.Empty();
+        yNormals.Empty();
+    }
+
+    FORCEINLINE SIZE_T GetAllocatedSize() const
+    {
+        return states.GetAllocatedSize()
+            + stateCounts.GetAllocatedSize()
+            + xEdges.GetAllocatedSize()
+            + yEdges.GetAllocatedSize()
+            + xNormals.GetAllocatedSize()
+            + yNormals.GetAllocatedSize()
+            + distances.GetAllocatedSize();
+    }
+
+    // Compact serialization.
+    //
+    // States are stored as run-length encoded (count, state) pairs,
+    // crossings are stored sparsely as index delta followed by quantized
+    // edge and normal for edges that have a valid crossing. Legacy data
+    // stores crossings as float edge and FVector2D normal. Signed distance
+    // data stores run-length encoded distances in place of crossings.
+    //
+    // Loaded layout is validated against the expected resolution and size
+    // (if non-zero) before voxel planes are allocated, loaded states are
+    // validated against the max state. Invalid records set the archive
+    // error and return false.
+
+    bool Serialize(
+        FArchive& Ar,
+        int32 Version = VersionLatest,
+        int32 expectedResolution = 0,
+        float expectedSize = 0.f,
+        bool bAllowSignedDistance = true,
+        int32 maxState = MaxStateCount-1
+        )
+    {
+        int32 resolution = voxelResolution;
+        float size = voxelSize;
+
+        Ar << resolution;
+        Ar << size;
+
+        // Signed distance flag is stored since distance version
+        uint8 bSignedDistance = (Ar.IsSaving() && HasDistances()) ? 1 : 0;
+
+        if (Version >= VersionDistances)
+        {
+            Ar << bSignedDistance;
+        }
+
+        if (Ar.IsLoading())
+        {
+            const bool bValidLayout = ! Ar.IsError()
+                && resolution > 0
+                && resolution <= MaxVoxelResolution
+                && (expectedResolution <= 0 || resolution == expectedResolution)
+                && FMath::IsFinite(size)
+                && size > 0.f
+                && (expectedSize <= 0.f || FMath::IsNearlyEqual(size, expectedSize, expectedSize * KINDA_SMALL_NUMBER))
+                && bSignedDistance <= 1
+                && (bAllowSignedDistance || ! bSignedDistance);
+
+            if (! bValidLayout)
+            {
+                Ar.SetError();
+                return false;
+            }
+
+            Initialize(resolution, size, bSignedDistance != 0);
+        }
+
+        SerializeStates(Ar, maxState);
+
+        if (bSignedDistance)
+        {
+            SerializeRuns(Ar, distances, TNumericLimits<uint16>::Max());
+        }
+        else if (Ar.IsLoading() && Version <= VersionLegacyCrossings)
+        {
+            LoadLegacyCrossings(Ar, xEdges, xNormals, true);
+            LoadLegacyCrossings(Ar, yEdges, yNormals, false);
+        }
+        else
+        {
+            SerializeCrossings(Ar, xEdges, xNormals);
+            SerializeCrossings(Ar, yEdges, yNormals);
+        }
+
+        return ! Ar.IsError();
+    }
+
+private:
+
+    void SerializeStates(FArchive& Ar, int32 maxState)
+    {
+        SerializeRuns(Ar, states, FMath::Clamp(maxState, 0, MaxStateCount-1));
+
+        if (Ar.IsLoading())
+        {
+            RebuildStateCounts();
+        }
+    }
+
+    template<typename ValueType>
+    void SerializeRuns(FArchive& Ar, TArray<ValueType>& values, uint32 maxValue)
+    {
+        const int32 valueCount = values.Num();
+
+        if (Ar.IsLoading())
+        {
+            uint32 runCount = 0;
+            Ar.SerializeIntPacked(runCount);
+
+            // More runs than values, invalid record
+            if (runCount > (uint32)valueCount)
+            {
+                Ar.SetError();
+                return;
+            }
+
+            uint32 i = 0;
+
+            for (uint32 r=0; r<runCount && !Ar.IsError(); ++r)
+            {
+                uint32 runLength = 0;
+                uint32 value = 0;
+                Ar.SerializeIntPacked(runLength);
+                Ar.SerializeIntPacked(value);
+
+                // Out of range value or run overflow, invalid record
+                if (value > maxValue || runLength > ((uint32)valueCount - i))
+                {
+                    Ar.SetError();
+                    return;
+                }
+
+                const uint32 runEnd = i + runLength;
+
+                for (; i<runEnd; ++i)
+                {
+                    values[i] = static_cast<ValueType>(value);
+                }
+            }
+
+            // Runs must cover every value
+            if (i != (uint32)valueCount)
+            {
+                Ar.SetError();
+            }
+        }
+        else
+        {
+            uint32 runCount = 0;
+
+            for (int32 i=0; i<valueCount; ++runCount)
+            {
+                const ValueType value = values[i];
+                while (i<valueCount && values[i] == value) ++i;
+            }
+
+            Ar.SerializeIntPacked(runCount);
+
+            for (int32 i=0; i<valueCount; )
+            {
+                const int32 runStart = i;
+                const ValueType value = values[i];
+
+                while (i<valueCount && values[i] == value) ++i;
+
+                uint32 runLength = i - runStart;
+                uint32 packedValue = value;
+                Ar.SerializeIntPacked(runLength);
+                Ar.SerializeIntPacked(packedValue);
+            }
+        }
+    }
+
+    void SerializeCrossings(FArchive& Ar, TArray<uint16>& edges, TArray<uint16>& normals)
+    {
+        const int32 voxelCount = Num();
+
+        if (Ar.IsLoading())
+        {
+            uint32 crossingCount = 0;
+            Ar.SerializeIntPacked(crossingCount);
+
+            // More crossings than voxels, invalid record
+            if (crossingCount > (uint32)voxelCount)
+            {
+                Ar.SetError();
+                return;
+            }
+
+            for (uint32 c=0, i=0; c<crossingCount && !Ar.IsError(); ++c)
+            {
+                uint32 indexDelta = 0;
+                Ar.SerializeIntPacked(indexDelta);
+
+                // Crossing index out of range, invalid record
+                if (indexDelta >= ((uint32)voxelCount - i))
+                {
+                    Ar.SetError();
+                    return;
+                }
+
+                i += indexDelta;
+
+                uint16 edge;
+                uint16 normal;
+                Ar << edge;
+                Ar << normal;
+
+                edges[i] = edge;
+                normals[i] = normal;
+            }
+        }
+        else
+        {
+            uint32 crossingCount = 0;
+
+            for (int32 i=0; i<voxelCount; ++i)
+            {
+                if (edges[i] != 0)
+                {
+                    ++crossingCount;
+                }
+            }
+
+            Ar.SerializeIntPacked(crossingCount);
+
+            for (int32 i=0, last=0; i<voxelCount; ++i)
+            {
+                if (edges[i] != 0)
+                {
+                    uint32 indexDelta = i - last;
+                    Ar.SerializeIntPacked(indexDelta);
+                    Ar << edges[i];
+                    Ar << normals[i];
+                    last = i;
+                }
+            }
+        }
+    }
+
+    void LoadLegacyCrossings(FArchive& Ar, TArray<uint16>& edges, TArray<uint16>& normals, bool bXEdges)
+    {
+        check(Ar.IsLoading());
+
+        const int32 voxelCount = Num();
+
+        uint32 crossingCount = 0;
+        Ar.SerializeIntPacked(crossingCount);
+
+        // More crossings than voxels, invalid record
+        if (crossingCount > (uint32)voxelCount)
+        {
+            Ar.SetError();
+            return;
+        }
+
+        for (uint32 c=0, i=0; c<crossingCount && !Ar.IsError(); ++c)
+        {
+            uint32 indexDelta = 0;
+            Ar.SerializeIntPacked(indexDelta);
+
+            // Crossing index out of range, invalid record
+            if (indexDelta >= ((uint32)voxelCount - i))
+            {
+                Ar.SetError();
+                return;
+            }
+
+            i += indexDelta;
+
+            float edge;
+            FVector2D normal;
+            Ar << edge;
+            Ar << normal;
+
+            const FVector2D position(GetPosition(i));
+            edges[i] = EncodeEdge(edge, bXEdges ? position.X : position.Y);
+            normals[i] = EncodeNormal(normal);
+        }
+    }
+};
@@ -26,12 +26,34 @@
 // 
 
 #include "PMUVoxelGrid.h"
+#include "ProceduralMeshUtility.h"
 #include "March/PMUVoxelStencil.h"
+#include "Async/ParallelFor.h"
 
 #ifdef PMU_VOXEL_USE_OCL
 #include "OCLBProgram.h"
 #endif
 
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelGrid ~ Triangulate"), STAT_PMUVoxelGrid_Triangulate, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelGrid ~ Triangulate Cell Rows"), STAT_PMUVoxelGrid_TriangulateCellRows, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelGrid ~ Append Bands"), STAT_PMUVoxelGrid_AppendBands, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelGrid ~ Build Merged Cells"), STAT_PMUVoxelGrid_BuildMergedCells, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelGrid ~ Set States"), STAT_PMUVoxelGrid_SetStates, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelGrid ~ Set Crossings"), STAT_PMUVoxelGrid_SetCrossings, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelGrid ~ Set Distances"), STAT_PMUVoxelGrid_SetDistances, STATGROUP_ProceduralMeshUtility);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Distance Voxel Writes"), STAT_PMUVoxelGrid_DistanceVoxelWrites, STATGROUP_ProceduralMeshUtility);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Triangulated Cells"), STAT_PMUVoxelGrid_TriangulatedCells, STATGROUP_ProceduralMeshUtility);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Empty Chunks"), STAT_PMUVoxelGrid_EmptyChunks, STATGROUP_ProceduralMeshUtility);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Uniform Chunks"), STAT_PMUVoxelGrid_UniformChunks, STATGROUP_ProceduralMeshUtility);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Surface States"), STAT_PMUVoxelGrid_ActiveStates, STATGROUP_ProceduralMeshUtility);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Merged Cells"), STAT_PMUVoxelGrid_MergedCells, STATGROUP_ProceduralMeshUtility);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LOD Chunks"), STAT_PMUVoxelGrid_LODChunks, STATGROUP_ProceduralMeshUtility);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Stitched LOD Border Vertices"), STAT_PMUVoxelGrid_StitchedVertices, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelGrid ~ Downsample Voxels"), STAT_PMUVoxelGrid_DownsampleVoxels, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelGrid ~ Stitch LOD Borders"), STAT_PMUVoxelGrid_StitchLODBorders, STATGROUP_ProceduralMeshUtility);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queued Simplifications"), STAT_PMUVoxelGrid_QueuedSimplifications, STATGROUP_ProceduralMeshUtility);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cancelled Simplifications"), STAT_PMUVoxelGrid_CancelledSimplifications, STATGROUP_ProceduralMeshUtility);
+
 void FPMUVoxelGrid::Initialize(const FPMUVoxelGridConfig& Config)
 {
     position = Config.Position;
@@ -39,16 +61,25 @@ void FPMUVoxelGrid::Initialize(const FPMUVoxelGridConfig& Config)
     voxelResolution = Config.VoxelResolution;
     voxelSize       = gridSize / voxelResolution;
 
+    triangulationBands = FMath::Max(1, Config.TriangulationBands);
+    bandGrids.Reset();
+
+    // Revalidate requested LOD against the new voxel resolution
+    lodLevel = 0;
+    SetLODLevel(lodRequest);
+    lodGrid.Reset();
+    lodBorderGrids.Reset();
+
+    CancelSimplification();
+    simplifyThreadPool = Config.SimplifyThreadPool;
+
     cell.sharpFeatureLimit = FMath::Cos(FMath::DegreesToRadians(Config.MaxFeatureAngle));
     cell.parallelLimit     = FMath::Cos(FMath::DegreesToRadians(Config.MaxParallelAngle));
 
-    voxels.SetNum(voxelResolution * voxelResolution);
-    
-    for (int32 y=0, i=0; y<voxelResolution; y++)
-    for (int32 x=0     ; x<voxelResolution; x++, i++)
-    {
-        CreateVoxel(i, x, y);
-    }
+    bSignedDistance = Config.bSignedDistance;
+
+    voxels.Renew();
+    voxels.Edit().Initialize(voxelResolution, voxelSize, bSignedDistance);
 
     CreateRenderers(Config);
 }
@@ -61,24 +92,121 @@ void FPMUVoxelGrid::CopyFrom(const FPMUVoxelGrid& Chunk)
     voxelSize       = Chunk.voxelSize;
 
     cell            = Chunk.cell;
-    voxels          = Chunk.voxels;
+    bDirty          = Chunk.IsDirty();
+    bSignedDistance = Chunk.bSignedDistance;
+
+    triangulationBands = Chunk.triangulationBands;
+    bandGrids.Reset();
+
+    lodLevel = Chunk.lodLevel;
+    lodRequest = Chunk.lodRequest;
+    FMemory::Memcpy(borderLODs, Chunk.borderLODs);
+    lodGrid.Reset();
+    lodBorderGrids.Reset();
+
+    // Pending simplification of the source chunk is not carried over,
+    // the copy keeps the raw sections until it is refreshed
+
+    CancelSimplification();
+    simplifyThreadPool = Chunk.simplifyThreadPool;
+
+    // Voxels and renderers are shared with the source chunk,
+    // either chunk clones its data on the first edit or refresh
+
+    voxels    = Chunk.voxels;
+    renderers = Chunk.renderers;
+}
+
+void FPMUVoxelGrid::DetachSharedData()
+{
+    voxels.Edit();
+    renderers.Edit();
+}
+
+void FPMUVoxelGrid::Evict()
+{
+    voxels.Renew();
+    renderers.Renew();
+    bandGrids.Reset();
+    lodGrid.Reset();
+    lodBorderGrids.Reset();
+    CancelSimplification();
+    bDirty = true;
+}
+
+bool FPMUVoxelGrid::SerializeVoxels(FArchive& Ar, int32 Version)
+{
+    if (Ar.IsLoading())
+    {
+        // Crossing records are accepted by signed distance chunks
+        // and converted by the map, not the other way around.
+        // States without a renderer are rejected, triangulation
+        // indexes renderers by state.
+        return voxels.Edit().Serialize(
+            Ar,
+            Version,
+            voxelResolution,
+            voxelSize,
+            bSignedDistance,
+            renderers->Num()-1
+            );
+    }
+    else
+    {
+        // Saving does not modify voxel data, avoid detaching shared voxels
+        return const_cast<FPMUVoxelData&>(voxels.Get()).Serialize(Ar);
+    }
+}
+
+SIZE_T FPMUVoxelGrid::GetAllocatedSize() const
+{
+    SIZE_T AllocatedSize = voxels->GetAllocatedSize();
 
-    // Construct & copy renderers
+    for (const FPMUVoxelRenderer& Renderer : *renderers)
+    {
+        AllocatedSize += Renderer.GetSurface().GetBufferAllocatedSize();
+    }
+
+    for (const TUniquePtr<FPMUVoxelGrid>& Band : bandGrids)
+    {
+        for (const FPMUVoxelRenderer& Renderer : *Band->renderers)
+        {
+            AllocatedSize += Renderer.GetSurface().GetBufferAllocatedSize();
+        }
+    }
 
-    renderers.SetNum(Chunk.renderers.Num());
+    if (lodGrid)
+    {
+        AllocatedSize += lodGrid->GetAllocatedSize();
+    }
 
-    for (int32 i=0; i<renderers.Num(); ++i)
+    for (const TUniquePtr<FPMUVoxelGrid>& Border : lodBorderGrids)
     {
-        renderers[i].CopyFrom(Chunk.renderers[i]);
+        AllocatedSize += Border->voxels->GetAllocatedSize();
     }
+
+    return AllocatedSize;
 }
 
 void FPMUVoxelGrid::CreateRenderers(const FPMUVoxelGridConfig& GridConfig)
 {
     // Construct renderer count
 
-    const int32 rendererCount = 1 + GridConfig.States.Num();
-    renderers.Reserve(rendererCount);
+    // Voxel states are stored as 8-bit values, excess surface states
+    // would not be addressable by voxel data
+
+    const int32 stateCount = GridConfig.States.Num();
+
+    ensureMsgf(stateCount < FPMUVoxelData::MaxStateCount,
+        TEXT("FPMUVoxelGrid::CreateRenderers() Surface state count (%d) exceeds voxel state limit (%d)"),
+        stateCount, FPMUVoxelData::MaxStateCount-1);
+
+    const int32 rendererCount = 1 + FMath::Min<int32>(stateCount, FPMUVoxelData::MaxStateCount-1);
+
+    renderers.Renew();
+
+    TArray<FPMUVoxelRenderer>& rendererArray(renderers.Edit());
+    rendererArray.Reserve(rendererCount);
 
     for (int32 i=0; i<rendererCount; ++i)
     {
@@ -104,6 +232,8 @@ void FPMUVoxelGrid::CreateRenderers(const FPMUVoxelGridConfig& GridConfig)
             Config.bGenerateExtrusion = State.bGenerateExtrusion;
             Config.bExtrusionSurface  = State.bExtrusionSurface;
             Config.SimplifierOptions  = State.SimplifierOptions;
+            Config.bMergeInteriorCells = State.bMergeInteriorCells;
+            Config.bDeferSimplification = GridConfig.SimplifyThreadPool != nullptr;
 
             if (IsValid(GradientConfig.GradientData) && IsValid(GradientConfig.DistanceFieldData))
             {
@@ -116,65 +246,334 @@ void FPMUVoxelGrid::CreateRenderers(const FPMUVoxelGridConfig& GridConfig)
             Config.bExtrusionSurface  = false;
         }
 
-        renderers.Emplace(Config);
+        rendererArray.Emplace(Config);
     }
 }
 
 void FPMUVoxelGrid::ResetVoxels()
 {
-    for (FPMUVoxel& voxel : voxels)
+    CancelSimplification();
+
+    // Shared voxels are replaced instead of being cloned then reset
+
+    if (voxels.IsShared())
     {
-        voxel.Reset();
+        const bool bResident = IsResident();
+
+        voxels.Renew();
+
+        if (bResident)
+        {
+            voxels.Edit().Initialize(voxelResolution, voxelSize, bSignedDistance);
+        }
+
+        return;
     }
+
+    voxels.Edit().Reset();
 }
 
 void FPMUVoxelGrid::Refresh()
 {
+    CancelSimplification();
+
     Triangulate();
+
+    if (simplifyThreadPool)
+    {
+        QueueSimplification();
+    }
+}
+
+void FPMUVoxelGrid::QueueSimplification()
+{
+    check(simplifyThreadPool != nullptr);
+
+    const TArray<FPMUVoxelRenderer>& rendererArray(*renderers);
+
+    FScopeLock Lock(&simplifyJobsLock);
+
+    for (int32 i=1; i<rendererArray.Num(); ++i)
+    {
+        const FPMUVoxelSurface& Surface(rendererArray[i].GetSurface());
+
+        if (! Surface.IsSimplificationDeferred() || Surface.GetVertexCount() == 0)
+        {
+            continue;
+        }
+
+        // Job simplifies a copy of the raw section, the raw section
+        // stays published until the simplified section is applied
+
+        FPSPMUVoxelSimplifyJob Job(MakeShared<FPMUVoxelSimplifyJob, ESPMode::ThreadSafe>());
+        Job->StateIndex = i;
+        Job->Section = Surface.Section;
+        Job->Options = Surface.SimplifierOptions;
+
+        simplifyJobs.Emplace(Job);
+
+        (new FAutoDeleteAsyncTask<FPMUVoxelSimplifyTask>(Job))->StartBackgroundTask(simplifyThreadPool);
+
+        INC_DWORD_STAT(STAT_PMUVoxelGrid_QueuedSimplifications);
+    }
+}
+
+void FPMUVoxelGrid::MarkSimplificationObsolete()
+{
+    FScopeLock Lock(&simplifyJobsLock);
+
+    for (FPSPMUVoxelSimplifyJob& Job : simplifyJobs)
+    {
+        if (! Job->bCancelled)
+        {
+            Job->bCancelled = true;
+            INC_DWORD_STAT(STAT_PMUVoxelGrid_CancelledSimplifications);
+        }
+    }
+}
+
+void FPMUVoxelGrid::CancelSimplification()
+{
+    MarkSimplificationObsolete();
+
+    FScopeLock Lock(&simplifyJobsLock);
+    simplifyJobs.Reset();
+}
+
+bool FPMUVoxelGrid::ApplySimplifiedSections()
+{
+    bool bApplied = false;
+
+    FScopeLock Lock(&simplifyJobsLock);
+
+    for (int32 i=simplifyJobs.Num()-1; i>=0; --i)
+    {
+        FPMUVoxelSimplifyJob& Job(*simplifyJobs[i]);
+
+        if (Job.bCancelled)
+        {
+            simplifyJobs.RemoveAtSwap(i, 1, false);
+            continue;
+        }
+
+        if (! Job.bCompleted)
+        {
+            continue;
+        }
+
+        if (HasRenderer(Job.StateIndex))
+        {
+            FPMUVoxelSurface& Surface(renderers.Edit()[Job.StateIndex].GetSurface());
+            Swap(Surface.Section, Job.Section);
+            bApplied = true;
+        }
+
+        simplifyJobs.RemoveAtSwap(i, 1, false);
+    }
+
+    return bApplied;
 }
 
 void FPMUVoxelGrid::Triangulate()
 {
-    for (int32 i=1; i<renderers.Num(); i++)
+    SCOPE_CYCLE_COUNTER(STAT_PMUVoxelGrid_Triangulate);
+
+    // Detach renderers shared with chunk copies before writing geometry
+
+    TArray<FPMUVoxelRenderer>& rendererArray(renderers.Edit());
+
+    for (int32 i=1; i<rendererArray.Num(); i++)
+    {
+        rendererArray[i].Clear();
+    }
+
+    if (lodLevel > 0)
+    {
+        TriangulateLOD();
+    }
+    else
+    {
+        TriangulateVoxels();
+    }
+
+    StitchLODBorders();
+}
+
+void FPMUVoxelGrid::TriangulateVoxels()
+{
+    TArray<FPMUVoxelRenderer>& rendererArray(renderers.GetMutable());
+
+    // Empty and uniformly filled chunks (including neighbour voxels
+    // used by gap cells) skip row cache walk entirely
+
+    const int32 uniformState = GetUniformState();
+
+    if (uniformState == 0)
+    {
+        INC_DWORD_STAT(STAT_PMUVoxelGrid_EmptyChunks);
+        return;
+    }
+    else if (HasRenderer(uniformState))
+    {
+        INC_DWORD_STAT(STAT_PMUVoxelGrid_UniformChunks);
+
+        const int32 cells = voxelResolution - 1;
+        FPMUVoxelRenderer& renderer(rendererArray[uniformState]);
+
+        renderer.FillUniform(
+            xNeighbor ? cells+1 : cells,
+            yNeighbor ? cells+1 : cells,
+            voxelSize
+            );
+        renderer.Apply();
+        return;
+    }
+
+    GatherActiveStates();
+
+    // No filled voxel, chunk does not generate any geometry
+    if (activeStates.Num() == 0)
+    {
+        return;
+    }
+
+    for (int32 state : activeStates)
     {
-        renderers[i].Clear();
+        rendererArray[state].InitializeRowCaches();
     }
 
-    FillFirstRowCache();
-    TriangulateCellRows();
+    BuildMergedCells();
+
+    const int32 bandCount = GetTriangulationBandCount();
+
+    if (bandCount > 1)
+    {
+        TriangulateBands(bandCount);
+    }
+    else
+    {
+        FillRowCache(0);
+        TriangulateCellRows(0, voxelResolution-1);
+    }
 
     if (yNeighbor)
     {
         TriangulateGapRow();
     }
 
-    for (int32 i=1; i<renderers.Num(); i++)
+    if (bHasMergedCells)
+    {
+        TriangulateMergedCells();
+    }
+
+    for (int32 state : activeStates)
     {
-        renderers[i].Apply();
+        rendererArray[state].Apply();
     }
 }
 
 void FPMUVoxelGrid::SetStates(const FPMUVoxelStencil& stencil, int32 xStart, int32 xEnd, int32 yStart, int32 yEnd)
 {
+    SCOPE_CYCLE_COUNTER(STAT_PMUVoxelGrid_SetStates);
+
     // Invalid stencil fill type, abort
     if (! HasRenderer(stencil.GetFillType()))
     {
         return;
     }
 
+    // Pending simplified sections no longer match edited voxels
+    MarkSimplificationObsolete();
+
+    FPMUVoxelData& voxelData(voxels.Edit());
+    FPMUVoxel voxel;
+
+    for (int32 y=yStart; y<=yEnd; y++)
+    {
+        int32 i = y*voxelResolution + xStart;
+        voxel.position.Y = voxels->GetCoordinate(y);
+
+        for (int32 x=xStart; x<=xEnd; x++, i++)
+        {
+            voxel.position.X = voxels->GetCoordinate(x);
+            voxel.state = voxelData.states[i];
+            stencil.ApplyVoxel(voxel);
+            voxelData.SetState(i, voxel.state);
+        }
+    }
+}
+
+void FPMUVoxelGrid::SetDistances(const FPMUVoxelStencil& stencil, int32 xStart, int32 xEnd, int32 yStart, int32 yEnd)
+{
+    SCOPE_CYCLE_COUNTER(STAT_PMUVoxelGrid_SetDistances);
+
+    const int32 fillType = stencil.GetFillType();
+
+    // Invalid stencil fill type, abort
+    if (! HasRenderer(fillType))
+    {
+        return;
+    }
+
+    MarkSimplificationObsolete();
+
+    FPMUVoxelData& voxelData(voxels.Edit());
+
+    check(voxelData.HasDistances());
+
+    INC_DWORD_STAT_BY(STAT_PMUVoxelGrid_DistanceVoxelWrites, (xEnd-xStart+1) * (yEnd-yStart+1));
+
+    // Stored distances are unsigned, a voxel inside the stencil takes
+    // the stencil fill type if it does not already have it. Stencil
+    // distance is negative inside the stencil.
+
     for (int32 y=yStart; y<=yEnd; y++)
     {
         int32 i = y*voxelResolution + xStart;
 
         for (int32 x=xStart; x<=xEnd; x++, i++)
         {
-            stencil.ApplyVoxel(voxels[i]);
+            const float distance = stencil.GetDistance(voxelData.GetPosition(x, y));
+
+            if (voxelData.states[i] == fillType)
+            {
+                voxelData.SetDistance(i, FMath::Max(voxelData.GetDistance(i), -distance));
+            }
+            else if (distance < 0.f)
+            {
+                voxelData.SetState(i, fillType);
+                voxelData.SetDistance(i, -distance);
+            }
+            else
+            {
+                voxelData.SetDistance(i, FMath::Min(voxelData.GetDistance(i), distance));
+            }
         }
     }
 }
 
+void FPMUVoxelGrid::ResolveBorderCrossings(int32 x, int32 y, FPMUVoxel& voxel) const
+{
+    // Crossings between chunks are derived from the distances
+    // of the neighbour first voxel column and row
+
+    const int32 last = voxelResolution-1;
+
+    if (x == last && xNeighbor)
+    {
+        voxels->DeriveXCrossing(x, y, *xNeighbor->voxels, 0, voxel);
+    }
+
+    if (y == last && yNeighbor)
+    {
+        voxels->DeriveYCrossing(x, y, *yNeighbor->voxels, 0, voxel);
+    }
+}
+
 void FPMUVoxelGrid::SetCrossings(const FPMUVoxelStencil& stencil, int32 xStart, int32 xEnd, int32 yStart, int32 yEnd)
 {
+    SCOPE_CYCLE_COUNTER(STAT_PMUVoxelGrid_SetCrossings);
+
     // Invalid stencil fill type, abort
     if (! HasRenderer(stencil.GetFillType()))
     {
@@ -208,94 +607,132 @@ void FPMUVoxelGrid::SetCrossings(const FPMUVoxelStencil& stencil, int32 xStart,
         crossVerticalGap = yNeighbor != nullptr;
     }
 
-    FPMUVoxel* a;
-    FPMUVoxel* b;
+    MarkSimplificationObsolete();
+
+    // Voxels are gathered into local copies, evaluated by the stencil
+    // and then have their crossings written back into voxel storage.
+    // Neighbour chunks may be setting their own crossings concurrently,
+    // gap crossings only read neighbour states which are already final.
+
+    FPMUVoxelData& voxelData(voxels.Edit());
+
+    FPMUVoxel a;
+    FPMUVoxel b;
+    FPMUVoxel c;
 
     for (int32 y = yStart; y <= yEnd; y++)
     {
         int32 i = y * voxelResolution + xStart;
-        b = &voxels[i];
+        voxelData.GetVoxel(xStart, y, b);
 
         for (int32 x = xStart; x <= xEnd; x++, i++)
         {
             a = b;
-            b = &voxels[i + 1];
-            stencil.SetHorizontalCrossing(*a, *b);
-            stencil.SetVerticalCrossing(*a, voxels[i + voxelResolution]);
+            voxelData.GetVoxel(x + 1, y, b);
+            voxelData.GetVoxel(x, y + 1, c);
+            stencil.SetHorizontalCrossing(a, b);
+            stencil.SetVerticalCrossing(a, c);
+            voxelData.SetCrossings(i, a);
         }
 
-        stencil.SetVerticalCrossing(*b, voxels[i + voxelResolution]);
+        voxelData.GetVoxel(xEnd + 1, y + 1, c);
+        stencil.SetVerticalCrossing(b, c);
 
         if (crossHorizontalGap)
         {
             check(xNeighbor);
             const int32 neighborIndex = y * voxelResolution;
-            if (xNeighbor->voxels.IsValidIndex(neighborIndex))
+            if (xNeighbor->voxels->IsValidIndex(neighborIndex))
             {
-                dummyX.BecomeXDummyOf(xNeighbor->voxels[neighborIndex], gridSize);
-                stencil.SetHorizontalCrossing(*b, dummyX);
+                dummyX.BecomeXDummyOf(xNeighbor->GetVoxelState(0, y), gridSize);
+                stencil.SetHorizontalCrossing(b, dummyX);
             }
         }
+
+        voxelData.SetCrossings(i, b);
     }
 
     if (includeLastVerticalRow)
     {
-        int32 i = voxels.Num() - voxelResolution + xStart;
-        b = &voxels[i];
+        const int32 y = voxelResolution - 1;
+        int32 i = voxelData.Num() - voxelResolution + xStart;
+        voxelData.GetVoxel(xStart, y, b);
 
         for (int32 x = xStart; x <= xEnd; x++, i++)
         {
             a = b;
-            b = &voxels[i + 1];
-            stencil.SetHorizontalCrossing(*a, *b);
+            voxelData.GetVoxel(x + 1, y, b);
+            stencil.SetHorizontalCrossing(a, b);
 
             if (crossVerticalGap)
             {
                 check(yNeighbor);
-                check(yNeighbor->voxels.IsValidIndex(x));
-                dummyY.BecomeYDummyOf(yNeighbor->voxels[x], gridSize);
-                stencil.SetVerticalCrossing(*a, dummyY);
+                check(yNeighbor->voxels->IsValidIndex(x));
+                dummyY.BecomeYDummyOf(yNeighbor->GetVoxelState(x, 0), gridSize);
+                stencil.SetVerticalCrossing(a, dummyY);
             }
+
+            voxelData.SetCrossings(i, a);
         }
 
         if (crossVerticalGap)
         {
             check(yNeighbor);
             const int32 neighborIndex = xEnd + 1;
-            if (yNeighbor->voxels.IsValidIndex(neighborIndex))
+            if (yNeighbor->voxels->IsValidIndex(neighborIndex))
             {
-                dummyY.BecomeYDummyOf(yNeighbor->voxels[neighborIndex], gridSize);
-                stencil.SetVerticalCrossing(*b, dummyY);
+                dummyY.BecomeYDummyOf(yNeighbor->GetVoxelState(neighborIndex, 0), gridSize);
+                stencil.SetVerticalCrossing(b, dummyY);
             }
         }
 
         if (crossHorizontalGap)
         {
             check(xNeighbor);
-            const int32 neighborIndex = voxels.Num() - voxelResolution;
-            if (xNeighbor->voxels.IsValidIndex(neighborIndex))
+            const int32 neighborIndex = voxelData.Num() - voxelResolution;
+            if (xNeighbor->voxels->IsValidIndex(neighborIndex))
             {
-                dummyX.BecomeXDummyOf(xNeighbor->voxels[neighborIndex], gridSize);
-                stencil.SetHorizontalCrossing(*b, dummyX);
+                dummyX.BecomeXDummyOf(xNeighbor->GetVoxelState(0, y), gridSize);
+                stencil.SetHorizontalCrossing(b, dummyX);
             }
         }
+
+        voxelData.SetCrossings(i, b);
     }
 }
 
-void FPMUVoxelGrid::FillFirstRowCache()
+void FPMUVoxelGrid::FillRowCache(int32 y)
 {
-    CacheFirstCorner(voxels[0]);
+    CacheFirstCorner(0, y);
 
-    int32 i;
-    for (i=0; i<voxelResolution-1; i++)
+    int32 x;
+    for (x=0; x<voxelResolution-1; x++)
     {
-        CacheNextEdgeAndCorner(i, voxels[i], voxels[i + 1]);
+        CacheNextEdgeAndCorner(x, y);
     }
 
     if (xNeighbor)
     {
-        dummyX.BecomeXDummyOf(xNeighbor->voxels[0], gridSize);
-        CacheNextEdgeAndCorner(i, voxels[i], dummyX);
+        dummyX.BecomeXDummyOf(xNeighbor->GetVoxel(0, y), gridSize);
+        CacheNextEdgeAndCorner(x, GetVoxel(x, y), dummyX);
+    }
+}
+
+void FPMUVoxelGrid::CacheFirstCorner(int32 x, int32 y)
+{
+    const int32 i = voxels->GetIndex(x, y);
+    const int32 state = voxels->states[i];
+
+    if (state > 0 && IsCornerRequired(i))
+    {
+        check(renderers->IsValidIndex(state));
+
+        const int32 vertexIndex = GetRenderer(state).CacheFirstCorner(voxels->GetPosition(x, y));
+
+        if (bHasMergedCells)
+        {
+            cornerVertices[i] = vertexIndex;
+        }
     }
 }
 
@@ -303,257 +740,1102 @@ void FPMUVoxelGrid::CacheFirstCorner(const FPMUVoxel& voxel)
 {
     if (voxel.IsFilled())
     {
-        check(renderers.IsValidIndex(voxel.state));
-        renderers[voxel.state].CacheFirstCorner(voxel);
+        check(renderers->IsValidIndex(voxel.state));
+        GetRenderer(voxel.state).CacheFirstCorner(voxel.position);
     }
 }
 
-void FPMUVoxelGrid::CacheNextEdgeAndCorner(int32 i, const FPMUVoxel& xMin, const FPMUVoxel& xMax)
+void FPMUVoxelGrid::CacheXEdge(int32 i, int32 minState, int32 maxState, const FVector2D& edgePoint)
 {
-    if (xMin.state != xMax.state)
+    if (minState > 0)
     {
-        if (xMin.IsFilled())
+        if (maxState > 0)
         {
-            if (xMax.IsFilled())
-            {
-                renderers[xMin.state].CacheXEdge(i, xMin);
-                renderers[xMax.state].CacheXEdge(i, xMin);
-            }
-            else
-            {
-                renderers[xMin.state].CacheXEdgeWithWall(i, xMin);
-            }
+            GetRenderer(minState).CacheXEdge(i, edgePoint);
+            GetRenderer(maxState).CacheXEdge(i, edgePoint);
         }
         else
         {
-            renderers[xMax.state].CacheXEdgeWithWall(i, xMin);
+            GetRenderer(minState).CacheXEdgeWithWall(i, edgePoint);
         }
     }
-    if (xMax.IsFilled())
+    else
     {
-        renderers[xMax.state].CacheNextCorner(i, xMax);
+        GetRenderer(maxState).CacheXEdgeWithWall(i, edgePoint);
     }
 }
 
-void FPMUVoxelGrid::CacheNextMiddleEdge(const FPMUVoxel& yMin, const FPMUVoxel& yMax)
+void FPMUVoxelGrid::CacheYEdge(int32 minState, int32 maxState, const FVector2D& edgePoint)
 {
-    for (int32 i=1; i<renderers.Num(); i++)
+    if (minState > 0)
     {
-        renderers[i].PrepareCacheForNextCell();
-    }
-    if (yMin.state != yMax.state)
-    {
-        if (yMin.IsFilled())
+        if (maxState > 0)
         {
-            if (yMax.IsFilled())
-            {
-                renderers[yMin.state].CacheYEdge(yMin);
-                renderers[yMax.state].CacheYEdge(yMin);
-            }
-            else
-            {
-                renderers[yMin.state].CacheYEdgeWithWall(yMin);
-            }
+            GetRenderer(minState).CacheYEdge(edgePoint);
+            GetRenderer(maxState).CacheYEdge(edgePoint);
         }
         else
         {
-            renderers[yMax.state].CacheYEdgeWithWall(yMin);
+            GetRenderer(minState).CacheYEdgeWithWall(edgePoint);
         }
     }
-}
-
-void FPMUVoxelGrid::SwapRowCaches()
-{
-    for (int32 i=1; i<renderers.Num(); i++)
+    else
     {
-        renderers[i].PrepareCacheForNextRow();
+        GetRenderer(maxState).CacheYEdgeWithWall(edgePoint);
     }
 }
 
-void FPMUVoxelGrid::TriangulateCellRows()
+void FPMUVoxelGrid::CacheNextEdgeAndCorner(int32 x, int32 y)
 {
-    int32 cells = voxelResolution - 1;
-    for (int32 i=0, y=0; y<cells; y++, i++)
+    const int32 i = voxels->GetIndex(x, y);
+    const int32 minState = voxels->states[i];
+    const int32 maxState = voxels->states[i + 1];
+
+    if (minState != maxState)
     {
-        SwapRowCaches();
-        CacheFirstCorner(voxels[i + voxelResolution]);
-        CacheNextMiddleEdge(voxels[i], voxels[i + voxelResolution]);
+        CacheXEdge(x, minState, maxState, voxels->GetXEdgePoint(x, y));
+    }
+    if (maxState > 0 && IsCornerRequired(i + 1))
+    {
+        const int32 vertexIndex = GetRenderer(maxState).CacheNextCorner(x, voxels->GetPosition(x + 1, y));
 
-        for (int32 x=0; x<cells; x++, i++)
+        if (bHasMergedCells)
         {
-            const FPMUVoxel&
-                a(voxels[i]),
-                b(voxels[i + 1]),
-                c(voxels[i + voxelResolution]),
-                d(voxels[i + voxelResolution + 1]);
-            CacheNextEdgeAndCorner(x, c, d);
-            CacheNextMiddleEdge(b, d);
-            TriangulateCell(x, a, b, c, d);
+            cornerVertices[i + 1] = vertexIndex;
         }
+    }
+}
 
-        if (xNeighbor)
-        {
-            TriangulateGapCell(i);
-        }
+void FPMUVoxelGrid::CacheNextEdgeAndCorner(int32 i, const FPMUVoxel& xMin, const FPMUVoxel& xMax)
+{
+    if (xMin.state != xMax.state)
+    {
+        CacheXEdge(i, xMin.state, xMax.state, xMin.GetXEdgePoint());
+    }
+    if (xMax.IsFilled())
+    {
+        GetRenderer(xMax.state).CacheNextCorner(i, xMax.position);
     }
 }
 
-void FPMUVoxelGrid::TriangulateGapRow()
+void FPMUVoxelGrid::CacheNextMiddleEdge(int32 x, int32 y)
 {
-    check(yNeighbor != nullptr);
+    for (int32 state : activeStates)
+    {
+        GetRenderer(state).PrepareCacheForNextCell();
+    }
 
-    dummyY.BecomeYDummyOf(yNeighbor->voxels[0], gridSize);
-    int32 cells = voxelResolution - 1;
-    int32 offset = cells * voxelResolution;
-    SwapRowCaches();
-    CacheFirstCorner(dummyY);
-    CacheNextMiddleEdge(voxels[cells * voxelResolution], dummyY);
+    const int32 i = voxels->GetIndex(x, y);
+    const int32 minState = voxels->states[i];
+    const int32 maxState = voxels->states[i + voxelResolution];
 
-    for (int32 x = 0; x < cells; x++)
+    if (minState != maxState)
+    {
+        CacheYEdge(minState, maxState, voxels->GetYEdgePoint(x, y));
+    }
+}
+
+void FPMUVoxelGrid::CacheNextMiddleEdge(const FPMUVoxel& yMin, const FPMUVoxel& yMax)
+{
+    for (int32 state : activeStates)
+    {
+        GetRenderer(state).PrepareCacheForNextCell();
+    }
+    if (yMin.state != yMax.state)
+    {
+        CacheYEdge(yMin.state, yMax.state, yMin.GetYEdgePoint());
+    }
+}
+
+void FPMUVoxelGrid::SwapRowCaches()
+{
+    for (int32 state : activeStates)
+    {
+        GetRenderer(state).PrepareCacheForNextRow();
+    }
+}
+
+void FPMUVoxelGrid::TriangulateCellRows(int32 yStart, int32 yEnd)
+{
+    SCOPE_CYCLE_COUNTER(STAT_PMUVoxelGrid_TriangulateCellRows);
+
+    const int32 cells = voxelResolution - 1;
+    INC_DWORD_STAT_BY(STAT_PMUVoxelGrid_TriangulatedCells, (yEnd-yStart) * (xNeighbor ? cells+1 : cells));
+    for (int32 y=yStart; y<yEnd; y++)
+    {
+        SwapRowCaches();
+        CacheFirstCorner(0, y + 1);
+        CacheNextMiddleEdge(0, y);
+
+        for (int32 x=0; x<cells; x++)
+        {
+            CacheNextEdgeAndCorner(x, y + 1);
+            CacheNextMiddleEdge(x + 1, y);
+            TriangulateCell(x, y);
+        }
+
+        if (xNeighbor)
+        {
+            TriangulateGapCell(y);
+        }
+    }
+}
+
+void FPMUVoxelGrid::TriangulateGapRow()
+{
+    check(yNeighbor != nullptr);
+
+    dummyY.BecomeYDummyOf(yNeighbor->GetVoxel(0, 0), gridSize);
+    const int32 cells = voxelResolution - 1;
+    SwapRowCaches();
+    CacheFirstCorner(dummyY);
+    CacheNextMiddleEdge(GetVoxel(0, cells), dummyY);
+
+    FPMUVoxel a;
+    FPMUVoxel b(GetVoxel(0, cells));
+
+    for (int32 x = 0; x < cells; x++)
     {
         Swap(dummyT, dummyY);
-        dummyY.BecomeYDummyOf(yNeighbor->voxels[x + 1], gridSize);
+        dummyY.BecomeYDummyOf(yNeighbor->GetVoxel(x + 1, 0), gridSize);
+
+        a = b;
+        b = GetVoxel(x + 1, cells);
 
         CacheNextEdgeAndCorner(x, dummyT, dummyY);
-        CacheNextMiddleEdge(voxels[x + offset + 1], dummyY);
-        TriangulateCell(
-            x,
-            voxels[x + offset],
-            voxels[x + offset + 1],
-            dummyT,
-            dummyY
-            );
+        CacheNextMiddleEdge(b, dummyY);
+        TriangulateCell(x, a, b, dummyT, dummyY);
     }
 
     if (xNeighbor)
     {
         check(xyNeighbor != nullptr);
 
-        dummyT.BecomeXYDummyOf(xyNeighbor->voxels[0], gridSize);
+        dummyT.BecomeXYDummyOf(xyNeighbor->GetVoxel(0, 0), gridSize);
 
         CacheNextEdgeAndCorner(cells, dummyY, dummyT);
         CacheNextMiddleEdge(dummyX, dummyT);
-        TriangulateCell(
-            cells,
-            voxels[voxels.Num() - 1],
-            dummyX,
-            dummyY,
-            dummyT
-            );
+        TriangulateCell(cells, b, dummyX, dummyY, dummyT);
     }
 }
 
-void FPMUVoxelGrid::TriangulateGapCell(int32 i)
+void FPMUVoxelGrid::TriangulateGapCell(int32 y)
 {
     check(xNeighbor != nullptr);
 
     Swap(dummyT, dummyX);
-    dummyX.BecomeXDummyOf(xNeighbor->voxels[i + 1], gridSize);
+    dummyX.BecomeXDummyOf(xNeighbor->GetVoxel(0, y + 1), gridSize);
+
+    const int32 cacheIndex = voxelResolution - 1;
+    const FPMUVoxel a(GetVoxel(cacheIndex, y));
+    const FPMUVoxel c(GetVoxel(cacheIndex, y + 1));
 
-    int32 cacheIndex = voxelResolution - 1;
-    CacheNextEdgeAndCorner(cacheIndex, voxels[i + voxelResolution], dummyX);
+    CacheNextEdgeAndCorner(cacheIndex, c, dummyX);
     CacheNextMiddleEdge(dummyT, dummyX);
 
-    TriangulateCell(
-        cacheIndex,
-        voxels[i],
-        dummyT,
-        voxels[i + voxelResolution],
-        dummyX
-        );
+    TriangulateCell(cacheIndex, a, dummyT, c, dummyX);
 }
 
-// Triangulation Functions
+int32 FPMUVoxelGrid::GetTriangulationBandCount() const
+{
+    // Merged cells record corner vertices across the whole chunk,
+    // bands also require at least two cell rows each
 
-void FPMUVoxelGrid::TriangulateCell(int32 i, const FPMUVoxel& a, const FPMUVoxel& b, const FPMUVoxel& c, const FPMUVoxel& d)
+    if (triangulationBands < 2 || bHasMergedCells)
+    {
+        return 1;
+    }
+
+    return FMath::Min(triangulationBands, (voxelResolution-1) / 2);
+}
+
+void FPMUVoxelGrid::TriangulateBands(int32 bandCount)
 {
-    cell.i = i;
-    cell.a = a;
-    cell.b = b;
-    cell.c = c;
-    cell.d = d;
+    check(bandCount > 1);
+
+    const int32 cells = voxelResolution - 1;
+
+    // Prepare worker grids, workers share chunk voxels and own
+    // renderers cloned from the chunk renderers
+
+    while (bandGrids.Num() < bandCount-1)
+    {
+        bandGrids.Emplace(MakeUnique<FPMUVoxelGrid>());
+    }
 
-    if (a.state == b.state)
+    for (int32 b=1; b<bandCount; ++b)
     {
-        if (a.state == c.state)
+        FPMUVoxelGrid& Band(*bandGrids[b-1]);
+
+        Band.position        = position;
+        Band.gridSize        = gridSize;
+        Band.voxelResolution = voxelResolution;
+        Band.voxelSize       = voxelSize;
+        Band.cell            = cell;
+        Band.xNeighbor       = xNeighbor;
+        Band.activeStates    = activeStates;
+        Band.voxels          = voxels;
+
+        if (Band.renderers->Num() != renderers->Num())
         {
-            if (a.state == d.state)
-            {
-                Triangulate0000();
-            }
-            else
-            {
-                Triangulate0001();
-            }
+            Band.renderers = renderers;
+            Band.renderers.Edit();
+        }
+
+        for (int32 state : activeStates)
+        {
+            FPMUVoxelRenderer& Renderer(Band.GetRenderer(state));
+            Renderer.Clear();
+            Renderer.InitializeRowCaches();
+        }
+    }
+
+    ParallelFor(bandCount, [&](int32 b)
+    {
+        const int32 yStart = (cells * b) / bandCount;
+        const int32 yEnd   = (cells * (b+1)) / bandCount;
+
+        if (b == 0)
+        {
+            FillRowCache(0);
+            TriangulateCellRows(0, yEnd);
         }
         else
         {
-            if (a.state == d.state)
-            {
-                Triangulate0010();
-            }
-            else if (c.state == d.state)
+            bandGrids[b-1]->TriangulateBand(yStart, yEnd);
+        }
+    });
+
+    // Append band geometry in row order
+
+    SCOPE_CYCLE_COUNTER(STAT_PMUVoxelGrid_AppendBands);
+
+    for (int32 b=1; b<bandCount; ++b)
+    {
+        FPMUVoxelGrid& Band(*bandGrids[b-1]);
+
+        for (int32 state : activeStates)
+        {
+            GetRenderer(state).GetSurface().AppendBand(Band.GetRenderer(state).GetSurface());
+        }
+
+        // Release shared voxels so that the next chunk edit does not clone them
+        Band.voxels.Renew();
+    }
+
+    // Gap row continues from the last band gap cell
+    dummyX = bandGrids[bandCount-2]->dummyX;
+}
+
+void FPMUVoxelGrid::TriangulateBand(int32 yStart, int32 yEnd)
+{
+    // Seam row vertices duplicate the last row of the previous band,
+    // they are recorded to be remapped on append
+
+    for (int32 state : activeStates)
+    {
+        GetRenderer(state).GetSurface().BeginBandSeam();
+    }
+
+    FillRowCache(yStart);
+
+    for (int32 state : activeStates)
+    {
+        GetRenderer(state).GetSurface().EndBandSeam();
+    }
+
+    TriangulateCellRows(yStart, yEnd);
+}
+
+int32 FPMUVoxelGrid::SetLODLevel(int32 LODLevel)
+{
+    lodRequest = FMath::Clamp(LODLevel, 0, MaxLODLevel);
+
+    int32 level = lodRequest;
+
+    // Downsampled grid requires voxel resolution divisible by LOD stride
+    // and at least two downsampled voxels per axis. Shell chunks have no
+    // resolution yet and keep the request until they are initialized.
+
+    while (voxelResolution > 0 && level > 0 && ((voxelResolution % (1 << level)) != 0 || (voxelResolution >> level) < 2))
+    {
+        --level;
+    }
+
+    if (lodLevel != level)
+    {
+        lodLevel = level;
+        bDirty = true;
+    }
+
+    return lodLevel;
+}
+
+bool FPMUVoxelGrid::SetBorderLOD(int32 Border, int32 LODLevel)
+{
+    check(Border >= 0 && Border < 4);
+
+    const int32 prevLOD = borderLODs[Border];
+
+    if (prevLOD != LODLevel)
+    {
+        borderLODs[Border] = LODLevel;
+
+        // Only borders with coarser neighbours are stitched
+        if (FMath::Max(prevLOD, LODLevel) > lodLevel)
+        {
+            bDirty = true;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+void FPMUVoxelGrid::TriangulateLOD()
+{
+    check(lodLevel > 0);
+
+    INC_DWORD_STAT(STAT_PMUVoxelGrid_LODChunks);
+
+    const int32 stride = 1 << lodLevel;
+    const int32 lodResolution = voxelResolution/stride;
+
+    // LOD grid mirrors the chunk layout. Gap cells towards the (+X, +Y,
+    // +XY) neighbours read downsampled neighbour voxels from border grids,
+    // map edge chunks without neighbours have no gap cells as in LOD 0.
+    // Renderers are cloned from the chunk renderers so that surface
+    // vertex placement and height sampling match LOD 0 surfaces.
+
+    if (! lodGrid)
+    {
+        lodGrid = MakeUnique<FPMUVoxelGrid>();
+    }
+
+    FPMUVoxelGrid& LOD(*lodGrid);
+
+    LOD.position        = position;
+    LOD.gridSize        = gridSize;
+    LOD.voxelResolution = lodResolution;
+    LOD.voxelSize       = voxelSize * stride;
+    LOD.cell            = cell;
+    LOD.triangulationBands = triangulationBands;
+
+    if (LOD.renderers->Num() != renderers->Num())
+    {
+        LOD.renderers = renderers;
+        LOD.renderers.Edit();
+    }
+
+    auto InitializeLODVoxels = [&](FPMUVoxelGrid& Grid) -> FPMUVoxelData&
+    {
+        FPMUVoxelData& lodVoxels(Grid.voxels.Edit());
+
+        if (lodVoxels.voxelResolution != lodResolution)
+        {
+            lodVoxels.Initialize(lodResolution, LOD.voxelSize);
+        }
+
+        lodVoxels.voxelOffset = voxels->voxelOffset;
+        return lodVoxels;
+    };
+
+    DownsampleVoxels(stride, InitializeLODVoxels(LOD));
+
+    const FPMUVoxelGrid* neighbors[3] = { xNeighbor, yNeighbor, xyNeighbor };
+    FPMUVoxelGrid** lodNeighbors[3] = { &LOD.xNeighbor, &LOD.yNeighbor, &LOD.xyNeighbor };
+
+    while (lodBorderGrids.Num() < 3)
+    {
+        lodBorderGrids.Emplace(MakeUnique<FPMUVoxelGrid>());
+    }
+
+    for (int32 border=0; border<3; ++border)
+    {
+        FPMUVoxelGrid& Border(*lodBorderGrids[border]);
+
+        if (neighbors[border])
+        {
+            Border.gridSize        = gridSize;
+            Border.voxelResolution = lodResolution;
+            Border.voxelSize       = LOD.voxelSize;
+
+            DownsampleBorderVoxels(stride, border, InitializeLODVoxels(Border));
+
+            *lodNeighbors[border] = &Border;
+        }
+        else
+        {
+            *lodNeighbors[border] = nullptr;
+        }
+    }
+
+    LOD.Triangulate();
+
+    // Move LOD geometry into chunk renderers, chunk sections are
+    // cleared and reused by the next LOD triangulation
+
+    TArray<FPMUVoxelRenderer>& rendererArray(renderers.GetMutable());
+
+    for (int32 i=1; i<rendererArray.Num(); ++i)
+    {
+        Swap(rendererArray[i].GetSurface().Section, LOD.GetRenderer(i).GetSurface().Section);
+    }
+}
+
+void FPMUVoxelGrid::DownsampleVoxel(int32 stride, int32 sx, int32 sy, bool bXEdge, bool bYEdge, FPMUVoxel& lodVoxel) const
+{
+    const float Lowest = TNumericLimits<float>::Lowest();
+
+    // Downsampled edge crossing is the first voxel crossing along the
+    // downsampled edge span, edge midpoint is used if there is none
+
+    auto FindCrossing = [&](bool bXSpan, float& edge, FVector2D& normal)
+    {
+        FPMUVoxel v0;
+        GetSourceVoxel(sx, sy, v0);
+
+        for (int32 k=0; k<stride; ++k)
+        {
+            FPMUVoxel v1;
+            GetSourceVoxel(bXSpan ? sx+k+1 : sx, bXSpan ? sy : sy+k+1, v1);
+
+            if (v0.state != v1.state)
             {
-                Triangulate0011();
+                const float edgeMin = bXSpan ? v0.position.X : v0.position.Y;
+                const float edgeMax = bXSpan ? v1.position.X : v1.position.Y;
+                const float crossing = bXSpan ? v0.xEdge : v0.yEdge;
+
+                if (crossing >= edgeMin && crossing <= edgeMax)
+                {
+                    edge = crossing;
+                    normal = bXSpan ? v0.xNormal : v0.yNormal;
+                    return;
+                }
             }
-            else
+
+            v0 = v1;
+        }
+    };
+
+    FPMUVoxel voxel;
+    GetSourceVoxel(sx, sy, voxel);
+
+    // Downsampled crossings are gathered into a local voxel
+    // and quantized relative to the downsampled voxel coordinate
+
+    lodVoxel.state = voxel.state;
+    lodVoxel.xEdge = Lowest;
+    lodVoxel.yEdge = Lowest;
+    lodVoxel.xNormal = FVector2D::ZeroVector;
+    lodVoxel.yNormal = FVector2D::ZeroVector;
+
+    if (bXEdge)
+    {
+        FPMUVoxel xMax;
+        GetSourceVoxel(sx+stride, sy, xMax);
+
+        if (voxel.state != xMax.state)
+        {
+            lodVoxel.xEdge = (voxel.position.X + xMax.position.X) * .5f;
+            FindCrossing(true, lodVoxel.xEdge, lodVoxel.xNormal);
+        }
+    }
+
+    if (bYEdge)
+    {
+        FPMUVoxel yMax;
+        GetSourceVoxel(sx, sy+stride, yMax);
+
+        if (voxel.state != yMax.state)
+        {
+            lodVoxel.yEdge = (voxel.position.Y + yMax.position.Y) * .5f;
+            FindCrossing(false, lodVoxel.yEdge, lodVoxel.yNormal);
+        }
+    }
+}
+
+void FPMUVoxelGrid::DownsampleVoxels(int32 stride, FPMUVoxelData& lodVoxels) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_PMUVoxelGrid_DownsampleVoxels);
+
+    const int32 lodResolution = lodVoxels.voxelResolution;
+
+    // Last column and row crossings span the gap towards the
+    // neighbour voxels, the same as LOD 0 border crossings
+
+    for (int32 y=0; y<lodResolution; ++y)
+    for (int32 x=0; x<lodResolution; ++x)
+    {
+        const int32 i = lodVoxels.GetIndex(x, y);
+        const bool bXEdge = x+1 < lodResolution || xNeighbor;
+        const bool bYEdge = y+1 < lodResolution || yNeighbor;
+
+        FPMUVoxel lodVoxel;
+        DownsampleVoxel(stride, x*stride, y*stride, bXEdge, bYEdge, lodVoxel);
+
+        lodVoxels.states[i] = static_cast<uint8>(lodVoxel.state);
+        lodVoxels.SetCrossings(i, lodVoxel);
+    }
+
+    lodVoxels.RebuildStateCounts();
+}
+
+void FPMUVoxelGrid::DownsampleBorderVoxels(int32 stride, int32 border, FPMUVoxelData& borderVoxels) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_PMUVoxelGrid_DownsampleVoxels);
+
+    const int32 lodResolution = borderVoxels.voxelResolution;
+    const bool bXBorder  = border == 0;
+    const bool bYBorder  = border == 1;
+    const bool bXYBorder = border == 2;
+
+    // Border grids only provide the first voxel column (+X), row (+Y)
+    // or voxel (+XY) of the neighbour. Remaining voxels repeat the state
+    // of their border voxel so that uniform neighbour checks still hold.
+
+    const int32 count = bXYBorder ? 1 : lodResolution;
+
+    for (int32 t=0; t<count; ++t)
+    {
+        const int32 sx = bYBorder ? t*stride : voxelResolution;
+        const int32 sy = bXBorder ? t*stride : voxelResolution;
+
+        // Crossings along the border span the far side of gap cells,
+        // the last one spans the corner gap cell towards +XY. They share
+        // chunk coordinates and are encoded as is.
+        const bool bSpan = t+1 < lodResolution || xyNeighbor;
+
+        FPMUVoxel lodVoxel;
+        DownsampleVoxel(stride, sx, sy, bYBorder && bSpan, bXBorder && bSpan, lodVoxel);
+
+        const uint8 state = static_cast<uint8>(lodVoxel.state);
+
+        if (bXYBorder)
+        {
+            FMemory::Memset(borderVoxels.states.GetData(), state, borderVoxels.Num());
+            borderVoxels.SetCrossings(0, lodVoxel);
+        }
+        else
+        {
+            borderVoxels.SetCrossings(bXBorder ? borderVoxels.GetIndex(0, t) : borderVoxels.GetIndex(t, 0), lodVoxel);
+
+            for (int32 k=0; k<lodResolution; ++k)
             {
-                Triangulate0012();
+                borderVoxels.states[bXBorder ? borderVoxels.GetIndex(k, t) : borderVoxels.GetIndex(t, k)] = state;
             }
         }
     }
+
+    borderVoxels.RebuildStateCounts();
+}
+
+void FPMUVoxelGrid::GetSourceVoxel(int32 x, int32 y, FPMUVoxel& voxel) const
+{
+    // Voxels beyond the chunk are taken from neighbours in chunk space.
+    // Map edge chunks without neighbours clamp to their last voxels.
+
+    const int32 last = voxelResolution-1;
+    const bool bBeyondX = x > last;
+    const bool bBeyondY = y > last;
+
+    if (! bBeyondX && ! bBeyondY)
+    {
+        voxel = GetVoxel(x, y);
+    }
+    else if (bBeyondX && bBeyondY && xyNeighbor)
+    {
+        voxel.BecomeXYDummyOf(xyNeighbor->GetVoxel(x-voxelResolution, y-voxelResolution), gridSize);
+    }
+    else if (bBeyondX && xNeighbor)
+    {
+        voxel.BecomeXDummyOf(xNeighbor->GetVoxel(x-voxelResolution, FMath::Min(y, last)), gridSize);
+    }
+    else if (bBeyondY && yNeighbor)
+    {
+        voxel.BecomeYDummyOf(yNeighbor->GetVoxel(FMath::Min(x, last), y-voxelResolution), gridSize);
+    }
     else
     {
-        if (a.state == c.state)
+        voxel = GetVoxel(FMath::Min(x, last), FMath::Min(y, last));
+    }
+}
+
+void FPMUVoxelGrid::StitchLODBorders()
+{
+    SCOPE_CYCLE_COUNTER(STAT_PMUVoxelGrid_StitchLODBorders);
+
+    TArray<FPMUVoxelRenderer>& rendererArray(renderers.GetMutable());
+
+    for (int32 border=0; border<4; ++border)
+    {
+        if (borderLODs[border] <= lodLevel)
         {
-            if (a.state == d.state)
-            {
-                Triangulate0100();
-            }
-            else if (b.state == d.state)
-            {
-                Triangulate0101();
-            }
-            else
-            {
-                Triangulate0102();
-            }
+            continue;
         }
-        else if (b.state == c.state)
+
+        for (int32 i=1; i<rendererArray.Num(); ++i)
         {
-            if (a.state == d.state)
-            {
-                Triangulate0110();
-            }
-            else if (b.state == d.state)
-            {
-                Triangulate0111();
-            }
-            else
-            {
-                Triangulate0112();
-            }
+            StitchLODBorder(rendererArray[i].GetSurface(), border, borderLODs[border]);
         }
-        else
+    }
+}
+
+void FPMUVoxelGrid::StitchLODBorder(FPMUVoxelSurface& surface, int32 border, int32 borderLOD)
+{
+    // Simplified surfaces no longer keep border vertices on the voxel
+    // lattice, they are left as is
+    if (surface.GetVertexCount() == 0 || surface.SimplifierOptions.bEnabled)
+    {
+        return;
+    }
+
+    TArray<FPMUMeshVertex>& Vertices(surface.Section.VertexBuffer);
+
+    const bool bXBorder = border < 2;
+    const float borderLine = (border & 1) ? gridSize : 0.f;
+    const float tolerance = voxelSize * .001f;
+    const float chunkStep  = voxelSize * (1 << lodLevel);
+    const float borderStep = voxelSize * (1 << borderLOD);
+
+    auto IsOnStep = [tolerance](float t, float step)
+    {
+        return FMath::Abs(t - FMath::RoundToFloat(t/step) * step) < tolerance;
+    };
+
+    // Gather surface vertices on the border line sorted by distance along
+    // the border. Extrusion vertices are generated right after their
+    // surface vertex and are stitched along with it.
+
+    struct FBorderVertex
+    {
+        float T;
+        int32 Index;
+    };
+
+    const int32 vertexStride = surface.bGenerateExtrusion ? 2 : 1;
+
+    TArray<FBorderVertex> BorderVertices;
+
+    for (int32 vi=0; vi<Vertices.Num(); vi+=vertexStride)
+    {
+        const FVector& Position(Vertices[vi].Position);
+        const float X = Position.X - position.X;
+        const float Y = Position.Y - position.Y;
+
+        if (FMath::Abs((bXBorder ? X : Y) - borderLine) < tolerance)
         {
-            if (a.state == d.state)
+            BorderVertices.Emplace(FBorderVertex { bXBorder ? Y : X, vi });
+        }
+    }
+
+    BorderVertices.Sort([](const FBorderVertex& A, const FBorderVertex& B)
+    {
+        return A.T < B.T;
+    });
+
+    // Height and normal of a T-junction vertex are interpolated
+    // between the vertices at the ends of the neighbour border edge
+
+    auto Interpolate = [&Vertices](int32 Index, int32 IndexA, int32 IndexB, float Alpha)
+    {
+        const FPMUMeshVertex& A(Vertices[IndexA]);
+        const FPMUMeshVertex& B(Vertices[IndexB]);
+        FPMUMeshVertex& Vertex(Vertices[Index]);
+
+        Vertex.Position.Z = FMath::Lerp(A.Position.Z, B.Position.Z, Alpha);
+        Vertex.Normal = FMath::Lerp(A.Normal, B.Normal, Alpha).GetSafeNormal();
+    };
+
+    // Vertices on the neighbour lattice and edge crossings are shared with
+    // the coarser neighbour. Remaining lattice vertices are T-junctions.
+
+    int32 anchor = INDEX_NONE;
+    int32 pendingStart = INDEX_NONE;
+
+    for (int32 bi=0; bi<BorderVertices.Num(); ++bi)
+    {
+        const FBorderVertex& BorderVertex(BorderVertices[bi]);
+        const bool bAnchor = IsOnStep(BorderVertex.T, borderStep) || ! IsOnStep(BorderVertex.T, chunkStep);
+
+        if (! bAnchor)
+        {
+            if (pendingStart == INDEX_NONE)
             {
-                Triangulate0120();
+                pendingStart = bi;
             }
-            else if (b.state == d.state)
+            continue;
+        }
+
+        if (anchor != INDEX_NONE && pendingStart != INDEX_NONE)
+        {
+            const FBorderVertex& A(BorderVertices[anchor]);
+            const float Span = BorderVertex.T - A.T;
+
+            for (int32 pi=pendingStart; pi<bi; ++pi)
             {
-                Triangulate0121();
+                const FBorderVertex& P(BorderVertices[pi]);
+                const float Alpha = Span > KINDA_SMALL_NUMBER ? (P.T - A.T) / Span : 0.f;
+
+                Interpolate(P.Index, A.Index, BorderVertex.Index, Alpha);
+
+                if (surface.bGenerateExtrusion)
+                {
+                    Interpolate(P.Index+1, A.Index+1, BorderVertex.Index+1, Alpha);
+                }
             }
-            else if (c.state == d.state)
+
+            INC_DWORD_STAT_BY(STAT_PMUVoxelGrid_StitchedVertices, bi-pendingStart);
+        }
+
+        anchor = bi;
+        pendingStart = INDEX_NONE;
+    }
+}
+}
+
+int32 FPMUVoxelGrid::GetUniformState() const
+{
+    const int32 state = voxels->GetUniformState();
+
+    if (state == INDEX_NONE)
+    {
+        return INDEX_NONE;
+    }
+
+    auto IsUniformNeighbor = [state](const FPMUVoxelGrid* neighbor)
+    {
+        return ! neighbor || neighbor->voxels->GetUniformState() == state;
+    };
+
+    if (IsUniformNeighbor(xNeighbor) &&
+        IsUniformNeighbor(yNeighbor) &&
+        IsUniformNeighbor(xyNeighbor))
+    {
+        return state;
+    }
+
+    return INDEX_NONE;
+}
+
+void FPMUVoxelGrid::GatherActiveStates()
+{
+    const int32 rendererCount = renderers->Num();
+
+    activeStates.Reset();
+    activeStateFlags.Init(false, rendererCount);
+
+    auto AddState = [&](int32 state)
+    {
+        if (state > 0 && state < rendererCount && ! activeStateFlags[state])
+        {
+            activeStateFlags[state] = true;
+            activeStates.Emplace(state);
+        }
+    };
+
+    const TArray<int32>& stateCounts(voxels->stateCounts);
+
+    for (int32 state=1; state<stateCounts.Num(); ++state)
+    {
+        if (stateCounts[state] > 0)
+        {
+            AddState(state);
+        }
+    }
+
+    // Gap cells and gap row also triangulate neighbour boundary voxels
+
+    if (xNeighbor)
+    {
+        for (int32 y=0; y<voxelResolution; ++y)
+        {
+            AddState(xNeighbor->voxels->states[y * voxelResolution]);
+        }
+    }
+
+    if (yNeighbor)
+    {
+        for (int32 x=0; x<voxelResolution; ++x)
+        {
+            AddState(yNeighbor->voxels->states[x]);
+        }
+    }
+
+    if (xyNeighbor)
+    {
+        AddState(xyNeighbor->voxels->states[0]);
+    }
+
+    INC_DWORD_STAT_BY(STAT_PMUVoxelGrid_ActiveStates, activeStates.Num());
+}
+
+void FPMUVoxelGrid::BuildMergedCells()
+{
+    bHasMergedCells = false;
+    mergedRects.Reset();
+
+    const int32 cells = voxelResolution - 1;
+    bool bHasMergingState = false;
+
+    for (int32 state : activeStates)
+    {
+        bHasMergingState |= (*renderers)[state].GetSurface().IsMergingInteriorCells();
+    }
+
+    if (! bHasMergingState || cells < 2)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_PMUVoxelGrid_BuildMergedCells);
+
+    const TArray<uint8>& states(voxels->states);
+    const int32 rendererCount = renderers->Num();
+
+    // Returns state of homogeneous cell with merging surface, zero otherwise
+
+    auto GetMergeState = [&](int32 x, int32 y)
+    {
+        const int32 i = voxels->GetIndex(x, y);
+        const int32 state = states[i];
+
+        const bool bMergeable = state > 0
+            && state < rendererCount
+            && state == states[i + 1]
+            && state == states[i + voxelResolution]
+            && state == states[i + voxelResolution + 1]
+            && (*renderers)[state].GetSurface().IsMergingInteriorCells();
+
+        return bMergeable ? state : 0;
+    };
+
+    // Greedy rectangles, grow along x then extend rows along y
+
+    mergedCells.Init(false, cells * cells);
+
+    int32 mergedCellCount = 0;
+
+    for (int32 y=0; y<cells; ++y)
+    for (int32 x=0; x<cells; ++x)
+    {
+        if (mergedCells[x + y*cells])
+        {
+            continue;
+        }
+
+        const int32 state = GetMergeState(x, y);
+
+        if (state == 0)
+        {
+            continue;
+        }
+
+        int32 x1 = x + 1;
+        int32 y1 = y + 1;
+
+        while (x1 < cells && ! mergedCells[x1 + y*cells] && GetMergeState(x1, y) == state)
+        {
+            ++x1;
+        }
+
+        for (; y1 < cells; ++y1)
+        {
+            int32 cx = x;
+
+            while (cx < x1 && ! mergedCells[cx + y1*cells] && GetMergeState(cx, y1) == state)
             {
-                Triangulate0122();
+                ++cx;
             }
-            else
+
+            if (cx < x1)
             {
-                Triangulate0123();
+                break;
             }
         }
+
+        // Single cells are triangulated as is
+
+        if ((x1-x) * (y1-y) < 2)
+        {
+            continue;
+        }
+
+        for (int32 cy=y; cy<y1; ++cy)
+        for (int32 cx=x; cx<x1; ++cx)
+        {
+            mergedCells[cx + cy*cells] = true;
+        }
+
+        mergedRects.Add(FMergedRect{ state, x, y, x1, y1 });
+        mergedCellCount += (x1-x) * (y1-y);
     }
+
+    if (mergedRects.Num() == 0)
+    {
+        return;
+    }
+
+    bHasMergedCells = true;
+
+    // Mark corners used by non-merged cells, gap cells and rectangle corners
+
+    requiredCorners.Init(false, voxelResolution * voxelResolution);
+
+    for (int32 y=0; y<cells; ++y)
+    for (int32 x=0; x<cells; ++x)
+    {
+        if (! mergedCells[x + y*cells])
+        {
+            const int32 i = voxels->GetIndex(x, y);
+            requiredCorners[i] = true;
+            requiredCorners[i + 1] = true;
+            requiredCorners[i + voxelResolution] = true;
+            requiredCorners[i + voxelResolution + 1] = true;
+        }
+    }
+
+    if (xNeighbor)
+    {
+        for (int32 y=0; y<voxelResolution; ++y)
+        {
+            requiredCorners[voxels->GetIndex(cells, y)] = true;
+        }
+    }
+
+    if (yNeighbor)
+    {
+        for (int32 x=0; x<voxelResolution; ++x)
+        {
+            requiredCorners[voxels->GetIndex(x, cells)] = true;
+        }
+    }
+
+    for (const FMergedRect& Rect : mergedRects)
+    {
+        requiredCorners[voxels->GetIndex(Rect.x0, Rect.y0)] = true;
+        requiredCorners[voxels->GetIndex(Rect.x1, Rect.y0)] = true;
+        requiredCorners[voxels->GetIndex(Rect.x0, Rect.y1)] = true;
+        requiredCorners[voxels->GetIndex(Rect.x1, Rect.y1)] = true;
+    }
+
+    cornerVertices.SetNumUninitialized(voxelResolution * voxelResolution, false);
+
+    INC_DWORD_STAT_BY(STAT_PMUVoxelGrid_MergedCells, mergedCellCount);
+}
+
+void FPMUVoxelGrid::TriangulateMergedCells()
+{
+    check(bHasMergedCells);
+
+    // Collect every required corner along rectangle perimeter so that
+    // adjacent cells and rectangles share edge vertices (no T-junctions)
+
+    auto AddPerimeterCorner = [&](int32 x, int32 y)
+    {
+        const int32 i = voxels->GetIndex(x, y);
+
+        if (requiredCorners[i])
+        {
+            mergedPerimeter.Emplace(cornerVertices[i]);
+        }
+    };
+
+    for (const FMergedRect& Rect : mergedRects)
+    {
+        mergedPerimeter.Reset();
+
+        for (int32 y=Rect.y0; y<Rect.y1; ++y) AddPerimeterCorner(Rect.x0, y);
+        for (int32 x=Rect.x0; x<Rect.x1; ++x) AddPerimeterCorner(x, Rect.y1);
+        for (int32 y=Rect.y1; y>Rect.y0; --y) AddPerimeterCorner(Rect.x1, y);
+        for (int32 x=Rect.x1; x>Rect.x0; --x) AddPerimeterCorner(x, Rect.y0);
+
+        const FVector2D center(
+            (voxels->GetPosition(Rect.x0, Rect.y0) + voxels->GetPosition(Rect.x1, Rect.y1)) * .5f
+            );
+
+        GetRenderer(Rect.state).GetSurface().AddMergedQuad(mergedPerimeter, center);
+    }
+}
+
+// Triangulation Functions
+
+// Cell case lookup, indexed by corner state equality pattern.
+// Case function names denote canonical corner labels in a, b, c, d order.
+
+const FPMUVoxelGrid::FCellCaseTable FPMUVoxelGrid::CellCaseTable;
+
+FPMUVoxelGrid::FCellCaseTable::FCellCaseTable()
+{
+    for (FCellCaseFunc& Func : Funcs)
+    {
+        Func = nullptr;
+    }
+
+    Funcs[GetCellCaseIndex(0, 0, 0, 0)] = &FPMUVoxelGrid::Triangulate0000;
+    Funcs[GetCellCaseIndex(0, 0, 0, 1)] = &FPMUVoxelGrid::Triangulate0001;
+    Funcs[GetCellCaseIndex(0, 0, 1, 0)] = &FPMUVoxelGrid::Triangulate0010;
+    Funcs[GetCellCaseIndex(0, 1, 0, 0)] = &FPMUVoxelGrid::Triangulate0100;
+    Funcs[GetCellCaseIndex(0, 1, 1, 1)] = &FPMUVoxelGrid::Triangulate0111;
+    Funcs[GetCellCaseIndex(0, 0, 1, 1)] = &FPMUVoxelGrid::Triangulate0011;
+    Funcs[GetCellCaseIndex(0, 1, 0, 1)] = &FPMUVoxelGrid::Triangulate0101;
+    Funcs[GetCellCaseIndex(0, 0, 1, 2)] = &FPMUVoxelGrid::Triangulate0012;
+    Funcs[GetCellCaseIndex(0, 1, 0, 2)] = &FPMUVoxelGrid::Triangulate0102;
+    Funcs[GetCellCaseIndex(0, 1, 2, 1)] = &FPMUVoxelGrid::Triangulate0121;
+    Funcs[GetCellCaseIndex(0, 1, 2, 2)] = &FPMUVoxelGrid::Triangulate0122;
+    Funcs[GetCellCaseIndex(0, 1, 1, 0)] = &FPMUVoxelGrid::Triangulate0110;
+    Funcs[GetCellCaseIndex(0, 1, 1, 2)] = &FPMUVoxelGrid::Triangulate0112;
+    Funcs[GetCellCaseIndex(0, 1, 2, 0)] = &FPMUVoxelGrid::Triangulate0120;
+    Funcs[GetCellCaseIndex(0, 1, 2, 3)] = &FPMUVoxelGrid::Triangulate0123;
+}
+
+void FPMUVoxelGrid::TriangulateCell(int32 x, int32 y)
+{
+    const TArray<uint8>& states(voxels->states);
+    const int32 i = voxels->GetIndex(x, y);
+    const int32 state = states[i];
+
+    // Homogeneous cell only requires voxel state, skip voxel data gathering
+    if (state == states[i + 1] &&
+        state == states[i + voxelResolution] &&
+        state == states[i + voxelResolution + 1])
+    {
+        if (state > 0 && ! (bHasMergedCells && mergedCells[x + y*(voxelResolution-1)]))
+        {
+            cell.i = x;
+            GetRenderer(state).FillABCD(cell);
+        }
+        return;
+    }
+
+    FPMUVoxel* gathered = cell.gathered;
+    voxels->GetVoxel(x    , y    , gathered[0]);
+    voxels->GetVoxel(x + 1, y    , gathered[1]);
+    voxels->GetVoxel(x    , y + 1, gathered[2]);
+    voxels->GetVoxel(x + 1, y + 1, gathered[3]);
+
+    cell.Set(x, gathered[0], gathered[1], gathered[2], gathered[3]);
+    TriangulateCellCase();
+}
+
+void FPMUVoxelGrid::TriangulateCell(int32 i, const FPMUVoxel& a, const FPMUVoxel& b, const FPMUVoxel& c, const FPMUVoxel& d)
+{
+    cell.Set(i, a, b, c, d);
+    TriangulateCellCase();
+}
+
+void FPMUVoxelGrid::TriangulateCellCase()
+{
+    const int32 caseIndex = GetCellCaseIndex(
+        cell.a->state,
+        cell.b->state,
+        cell.c->state,
+        cell.d->state
+        );
+
+    checkSlow(CellCaseTable.Funcs[caseIndex] != nullptr);
+    (this->*CellCaseTable.Funcs[caseIndex])();
 }
 
 void FPMUVoxelGrid::Triangulate0000()
@@ -660,7 +1942,7 @@ void FPMUVoxelGrid::Triangulate0110()
         FillBCToA(fA);
         FillBCToD(fD);
     }
-    else if (cell.a.IsFilled() && cell.b.IsFilled())
+    else if (cell.a->IsFilled() && cell.b->IsFilled())
     {
         FillJoinedCorners(fA, fB, fC, fD);
     }
@@ -689,7 +1971,7 @@ void FPMUVoxelGrid::Triangulate0112()
         FillBCToA(fA);
         FillBCToD(fD);
     }
-    else if (cell.b.IsFilled() || cell.HasConnectionAD(fA, fD))
+    else if (cell.b->IsFilled() || cell.HasConnectionAD(fA, fD))
     {
         FillJoinedCorners(fA, fB, fC, fD);
     }
@@ -716,7 +1998,7 @@ void FPMUVoxelGrid::Triangulate0120()
         FillB(fB);
         FillC(fC);
     }
-    else if (cell.a.IsFilled() || cell.HasConnectionBC(fB, fC))
+    else if (cell.a->IsFilled() || cell.HasConnectionBC(fB, fC))
     {
         FillJoinedCorners(fA, fB, fC, fD);
     }
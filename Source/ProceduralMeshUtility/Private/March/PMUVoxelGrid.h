@@ -28,10 +28,16 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Misc/ScopeLock.h"
 #include "PMUVoxel.h"
 #include "PMUVoxelCell.h"
+#include "PMUVoxelData.h"
 #include "PMUVoxelFeaturePoint.h"
 #include "PMUVoxelRenderer.h"
+#include "PMUVoxelSharedData.h"
+#include "PMUVoxelSimplifyTask.h"
 #include "PMUVoxelSurface.h"
 #include "March/PMUVoxelTypes.h"
 #include "Mesh/PMUMeshTypes.h"
@@ -47,8 +53,10 @@ private:
 
     FPMUVoxelCell cell;
 
-    TArray<FPMUVoxelRenderer> renderers;
-    TArray<FPMUVoxel> voxels;
+    // Copy-on-write, shared between chunk copies
+
+    TPMUVoxelSharedData<TArray<FPMUVoxelRenderer>> renderers;
+    TPMUVoxelSharedData<FPMUVoxelData> voxels;
 
     float gridSize;
     float voxelSize;
@@ -58,26 +66,153 @@ private:
     FPMUVoxel dummyY;
     FPMUVoxel dummyT;
 
+    // Whether voxel data is initialized with signed distances
+    bool bSignedDistance = false;
+
+    // Whether voxel data have changed since the last triangulation
+    FThreadSafeBool bDirty = true;
+
+    // Merged interior cell rectangles (corner ranges), rebuilt on triangulation.
+    // Only corners used by non-merged cells or rectangle corners are required.
+
+    struct FMergedRect
+    {
+        int32 state;
+        int32 x0;
+        int32 y0;
+        int32 x1;
+        int32 y1;
+    };
+
+    TArray<FMergedRect> mergedRects;
+    TBitArray<> mergedCells;
+    TBitArray<> requiredCorners;
+    TArray<int32> cornerVertices;
+    TArray<int32> mergedPerimeter;
+    bool bHasMergedCells = false;
+
+    // Surface states that occur in the chunk or its neighbour gap voxels,
+    // row cache maintenance is restricted to these states
+
+    TArray<int32> activeStates;
+    TBitArray<> activeStateFlags;
+
+    // Row band triangulation. Bands after the first are triangulated by
+    // worker grids starting from a seam row, band geometry is appended
+    // to the chunk renderers with seam vertices remapped afterwards.
+
+    int32 triangulationBands = 1;
+    TArray<TUniquePtr<FPMUVoxelGrid>> bandGrids;
+
+    // Chunk level of detail. Chunks above LOD 0 are triangulated by a
+    // LOD grid from voxel states sampled every (1 << lodLevel) voxels,
+    // border LODs are the levels of the (-X, +X, -Y, +Y) neighbours.
+    // LOD border grids hold downsampled first voxel column and row of
+    // the (+X, +Y, +XY) neighbours, used by the LOD grid gap cells.
+    // LOD state is view state and survives chunk (re)initialization,
+    // the requested level is reapplied once voxel resolution is known.
+
+    int32 lodLevel = 0;
+    int32 lodRequest = 0;
+    int32 borderLODs[4] = { 0, 0, 0, 0 };
+    TUniquePtr<FPMUVoxelGrid> lodGrid;
+    TArray<TUniquePtr<FPMUVoxelGrid>> lodBorderGrids;
+
+    // Deferred simplification. Refresh publishes raw geometry and queues
+    // simplification of each simplified surface on the background pool.
+
+    // Job list is guarded by simplifyJobsLock, voxel edit tasks mark
+    // jobs obsolete while the game thread applies completed jobs.
+
+    FQueuedThreadPool* simplifyThreadPool = nullptr;
+    TArray<FPSPMUVoxelSimplifyJob> simplifyJobs;
+    mutable FCriticalSection simplifyJobsLock;
+
+    void QueueSimplification();
+
+    // Flags queued jobs obsolete without releasing them, used by voxel
+    // edits that may run while the chunk jobs are being applied
+    void MarkSimplificationObsolete();
+
     void CreateRenderers(const FPMUVoxelGridConfig& Config);
     void ResetVoxels();
     void Refresh();
     void Triangulate();
+    void TriangulateVoxels();
     void SetStates(const FPMUVoxelStencil& stencil, int32 xStart, int32 xEnd, int32 yStart, int32 yEnd);
     void SetCrossings(const FPMUVoxelStencil& stencil, int32 xStart, int32 xEnd, int32 yStart, int32 yEnd);
 
-    void FillFirstRowCache();
+    // Signed distance edit, voxels of the stencil fill type are united
+    // with the stencil distance and other states are subtracted from it
+    void SetDistances(const FPMUVoxelStencil& stencil, int32 xStart, int32 xEnd, int32 yStart, int32 yEnd);
+
+    // Derive crossings of last column and row voxels from neighbour distances
+    void ResolveBorderCrossings(int32 x, int32 y, FPMUVoxel& voxel) const;
+
+    void FillRowCache(int32 y);
+    void CacheFirstCorner(int32 x, int32 y);
     void CacheFirstCorner(const FPMUVoxel& voxel);
+    void CacheXEdge(int32 i, int32 minState, int32 maxState, const FVector2D& edgePoint);
+    void CacheYEdge(int32 minState, int32 maxState, const FVector2D& edgePoint);
+    void CacheNextEdgeAndCorner(int32 x, int32 y);
     void CacheNextEdgeAndCorner(int32 i, const FPMUVoxel& xMin, const FPMUVoxel& xMax);
+    void CacheNextMiddleEdge(int32 x, int32 y);
     void CacheNextMiddleEdge(const FPMUVoxel& yMin, const FPMUVoxel& yMax);
     void SwapRowCaches();
     
-    void TriangulateCellRows();
+    void TriangulateCellRows(int32 yStart, int32 yEnd);
     void TriangulateGapRow();
-    void TriangulateGapCell(int32 i);
+    void TriangulateGapCell(int32 y);
+
+    int32 GetUniformState() const;
+    void GatherActiveStates();
+    void BuildMergedCells();
+    void TriangulateMergedCells();
+
+    int32 GetTriangulationBandCount() const;
+    void TriangulateBands(int32 bandCount);
+    void TriangulateBand(int32 yStart, int32 yEnd);
+
+    void TriangulateLOD();
+    void DownsampleVoxels(int32 stride, FPMUVoxelData& lodVoxels) const;
+    void DownsampleBorderVoxels(int32 stride, int32 border, FPMUVoxelData& borderVoxels) const;
+    void DownsampleVoxel(int32 stride, int32 sx, int32 sy, bool bXEdge, bool bYEdge, FPMUVoxel& lodVoxel) const;
+    void GetSourceVoxel(int32 x, int32 y, FPMUVoxel& voxel) const;
+    void StitchLODBorders();
+    void StitchLODBorder(FPMUVoxelSurface& surface, int32 border, int32 borderLOD);
+
+    FORCEINLINE bool IsCornerRequired(int32 i) const
+    {
+        return ! bHasMergedCells || requiredCorners[i];
+    }
 
     // Triangulation Functions
 
+    void TriangulateCell(int32 x, int32 y);
     void TriangulateCell(int32 i, const FPMUVoxel& a, const FPMUVoxel& b, const FPMUVoxel& c, const FPMUVoxel& d);
+    void TriangulateCellCase();
+
+    // Packed cell case index, one bit for each corner pair with equal state
+
+    FORCEINLINE static constexpr int32 GetCellCaseIndex(int32 a, int32 b, int32 c, int32 d)
+    {
+        return  int32(a == b)
+            | (int32(a == c) << 1)
+            | (int32(a == d) << 2)
+            | (int32(b == c) << 3)
+            | (int32(b == d) << 4)
+            | (int32(c == d) << 5);
+    }
+
+    typedef void (FPMUVoxelGrid::*FCellCaseFunc)();
+
+    struct FCellCaseTable
+    {
+        FCellCaseFunc Funcs[64];
+        FCellCaseTable();
+    };
+
+    static const FCellCaseTable CellCaseTable;
 
 public:
 
@@ -87,26 +222,134 @@ public:
     FPMUVoxelGrid* yNeighbor = nullptr;
     FPMUVoxelGrid* xyNeighbor = nullptr;
 
+    ~FPMUVoxelGrid()
+    {
+        CancelSimplification();
+    }
+
     void Initialize(const FPMUVoxelGridConfig& Config);
     void CopyFrom(const FPMUVoxelGrid& Chunk);
 
+    FORCEINLINE bool IsDirty() const
+    {
+        return bDirty;
+    }
+
+    // Whether the chunk has allocated voxel data and renderers.
+    // Non-resident chunks only keep their position and neighbour links.
+    FORCEINLINE bool IsResident() const
+    {
+        return voxels->Num() > 0;
+    }
+
+    void Evict();
+    void DetachSharedData();
+    // Loaded voxel records are validated against the chunk configuration,
+    // returns false and sets the archive error on invalid records
+    bool SerializeVoxels(FArchive& Ar, int32 Version = FPMUVoxelData::VersionLatest);
+    SIZE_T GetAllocatedSize() const;
+
+    // Whether chunk voxels store signed distances instead of crossings
+    FORCEINLINE bool HasDistances() const
+    {
+        return voxels->HasDistances();
+    }
+
+    FORCEINLINE void MarkDirty()
+    {
+        bDirty = true;
+    }
+
+    FORCEINLINE void ClearDirty()
+    {
+        bDirty = false;
+    }
+
+    // Cancels queued and running simplification jobs of the chunk
+    void CancelSimplification();
+
+    FORCEINLINE int32 GetPendingSimplificationCount() const
+    {
+        FScopeLock Lock(&simplifyJobsLock);
+        return simplifyJobs.Num();
+    }
+
+    // Swaps completed simplified sections into chunk renderers,
+    // returns whether any section has been replaced
+    bool ApplySimplifiedSections();
+
+    // Maximum supported chunk LOD, LOD 3 samples every 8th voxel
+    static constexpr int32 MaxLODLevel = 3;
+
+    FORCEINLINE int32 GetLODLevel() const
+    {
+        return lodLevel;
+    }
+
+    // Sets chunk LOD, clamped to the highest level that evenly divides
+    // voxel resolution. Returns the LOD level that has been applied,
+    // chunks without voxel resolution apply the request on Initialize().
+    int32 SetLODLevel(int32 LODLevel);
+
+    // Sets neighbour LOD used to stitch chunk border vertices,
+    // returns whether the border LOD has changed
+    bool SetBorderLOD(int32 Border, int32 LODLevel);
+
     FORCEINLINE bool HasRenderer(int32 RendererIndex) const
     {
-        return renderers.IsValidIndex(RendererIndex);
+        return renderers->IsValidIndex(RendererIndex);
     }
 
     FORCEINLINE int32 GetVertexCount(int32 StateIndex) const
     {
         return HasRenderer(StateIndex)
-            ? renderers[StateIndex].GetSurface().GetVertexCount()
+            ? (*renderers)[StateIndex].GetSurface().GetVertexCount()
             : 0;
     }
 
+    FORCEINLINE int32 GetBufferAllocationCount() const
+    {
+        int32 AllocationCount = 0;
+
+        for (const FPMUVoxelRenderer& Renderer : *renderers)
+        {
+            AllocationCount += Renderer.GetSurface().GetBufferAllocationCount();
+        }
+
+        return AllocationCount;
+    }
+
+    void ShrinkBuffers()
+    {
+        // Shared renderers are left as is, shrinking would clone them
+
+        if (renderers.IsShared())
+        {
+            return;
+        }
+
+        for (FPMUVoxelRenderer& Renderer : renderers.GetMutable())
+        {
+            Renderer.ShrinkBuffers();
+        }
+    }
+
     FORCEINLINE const FPMUMeshSection* GetSection(int32 StateIndex) const
     {
         if (HasRenderer(StateIndex))
         {
-            return &renderers[StateIndex].GetSurface().Section;
+            return &(*renderers)[StateIndex].GetSurface().Section;
+        }
+
+        return nullptr;
+    }
+
+    // Mutable section access, requires detached renderers
+    FORCEINLINE FPMUMeshSection* GetMutableSection(int32 StateIndex)
+    {
+        if (HasRenderer(StateIndex))
+        {
+            return &GetRenderer(StateIndex).GetSurface().Section;
         }
 
         return nullptr;
@@ -114,144 +357,167 @@ public:
 
 private:
 
-    FORCEINLINE void CreateVoxel(int32 i, int32 x, int32 y)
+    FORCEINLINE FPMUVoxel GetVoxel(int32 x, int32 y) const
     {
-        voxels[i].Set(x, y, voxelSize);
+        FPMUVoxel voxel;
+        voxels->GetVoxel(x, y, voxel);
+
+        if (voxels->HasDistances())
+        {
+            ResolveBorderCrossings(x, y, voxel);
+        }
+
+        return voxel;
     }
-    
+
+    FORCEINLINE FPMUVoxel GetVoxelState(int32 x, int32 y) const
+    {
+        FPMUVoxel voxel;
+        voxels->GetVoxelState(x, y, voxel);
+        return voxel;
+    }
+
+    // Renderer access during triangulation, renderers are detached
+    // at the start of triangulation
+
+    FORCEINLINE FPMUVoxelRenderer& GetRenderer(int32 i)
+    {
+        return renderers.GetMutable()[i];
+    }
+
     FORCEINLINE void FillA(const FPMUVoxelFeaturePoint& f)
     {
-        if (cell.a.IsFilled())
+        if (cell.a->IsFilled())
         {
-            renderers[cell.a.state].FillA(cell, f);
+            GetRenderer(cell.a->state).FillA(cell, f);
         }
     }
 
     FORCEINLINE void FillB(const FPMUVoxelFeaturePoint& f)
     {
-        if (cell.b.IsFilled())
+        if (cell.b->IsFilled())
         {
-            renderers[cell.b.state].FillB(cell, f);
+            GetRenderer(cell.b->state).FillB(cell, f);
         }
     }
     
     FORCEINLINE void FillC(const FPMUVoxelFeaturePoint& f)
     {
-        if (cell.c.IsFilled())
+        if (cell.c->IsFilled())
         {
-            renderers[cell.c.state].FillC(cell, f);
+            GetRenderer(cell.c->state).FillC(cell, f);
         }
     }
     
     FORCEINLINE void FillD(const FPMUVoxelFeaturePoint& f)
     {
-        if (cell.d.IsFilled())
+        if (cell.d->IsFilled())
         {
-            renderers[cell.d.state].FillD(cell, f);
+            GetRenderer(cell.d->state).FillD(cell, f);
         }
     }
 
     FORCEINLINE void FillABC(const FPMUVoxelFeaturePoint& f)
     {
-        if (cell.a.IsFilled())
+        if (cell.a->IsFilled())
         {
-            renderers[cell.a.state].FillABC(cell, f);
+            GetRenderer(cell.a->state).FillABC(cell, f);
         }
     }
     
     FORCEINLINE void FillABD(const FPMUVoxelFeaturePoint& f)
     {
-        if (cell.a.IsFilled())
+        if (cell.a->IsFilled())
         {
-            renderers[cell.a.state].FillABD(cell, f);
+            GetRenderer(cell.a->state).FillABD(cell, f);
         }
     }
     
     FORCEINLINE void FillACD(const FPMUVoxelFeaturePoint& f)
     {
-        if (cell.a.IsFilled())
+        if (cell.a->IsFilled())
         {
-            renderers[cell.a.state].FillACD(cell, f);
+            GetRenderer(cell.a->state).FillACD(cell, f);
         }
     }
     
     FORCEINLINE void FillBCD(const FPMUVoxelFeaturePoint& f)
     {
-        if (cell.b.IsFilled())
+        if (cell.b->IsFilled())
         {
-            renderers[cell.b.state].FillBCD(cell, f);
+            GetRenderer(cell.b->state).FillBCD(cell, f);
         }
     }
 
     FORCEINLINE void FillAB(const FPMUVoxelFeaturePoint& f)
     {
-        if (cell.a.IsFilled())
+        if (cell.a->IsFilled())
         {
-            renderers[cell.a.state].FillAB(cell, f);
+            GetRenderer(cell.a->state).FillAB(cell, f);
         }
     }
     
     FORCEINLINE void FillAC(const FPMUVoxelFeaturePoint& f)
     {
-        if (cell.a.IsFilled())
+        if (cell.a->IsFilled())
         {
-            renderers[cell.a.state].FillAC(cell, f);
+            GetRenderer(cell.a->state).FillAC(cell, f);
         }
     }
     
     FORCEINLINE void FillBD(const FPMUVoxelFeaturePoint& f)
     {
-        if (cell.b.IsFilled())
+        if (cell.b->IsFilled())
         {
-            renderers[cell.b.state].FillBD(cell, f);
+            GetRenderer(cell.b->state).FillBD(cell, f);
         }
     }
     
     FORCEINLINE void FillCD(const FPMUVoxelFeaturePoint& f)
     {
-        if (cell.c.IsFilled())
+        if (cell.c->IsFilled())
         {
-            renderers[cell.c.state].FillCD(cell, f);
+            GetRenderer(cell.c->state).FillCD(cell, f);
         }
     }
 
     FORCEINLINE void FillADToB(const FPMUVoxelFeaturePoint& f)
     {
-        if (cell.a.IsFilled())
+        if (cell.a->IsFilled())
         {
-            renderers[cell.a.state].FillADToB(cell, f);
+            GetRenderer(cell.a->state).FillADToB(cell, f);
         }
     }
     
     FORCEINLINE void FillADToC(const FPMUVoxelFeaturePoint& f)
     {
-        if (cell.a.IsFilled())
+        if (cell.a->IsFilled())
         {
-            renderers[cell.a.state].FillADToC(cell, f);
+            GetRenderer(cell.a->state).FillADToC(cell, f);
         }
     }
     
     FORCEINLINE void FillBCToA(const FPMUVoxelFeaturePoint& f)
     {
-        if (cell.b.IsFilled())
+        if (cell.b->IsFilled())
         {
-            renderers[cell.b.state].FillBCToA(cell, f);
+            GetRenderer(cell.b->state).FillBCToA(cell, f);
         }
     }
     
     FORCEINLINE void FillBCToD(const FPMUVoxelFeaturePoint& f)
     {
-        if (cell.b.IsFilled())
+        if (cell.b->IsFilled())
         {
-            renderers[cell.b.state].FillBCToD(cell, f);
+            GetRenderer(cell.b->state).FillBCToD(cell, f);
         }
     }
 
     FORCEINLINE void FillABCD()
     {
-        if (cell.a.IsFilled())
+        if (cell.a->IsFilled())
         {
-            renderers[cell.a.state].FillABCD(cell);
+            GetRenderer(cell.a->state).FillABCD(cell);
         }
     }
 
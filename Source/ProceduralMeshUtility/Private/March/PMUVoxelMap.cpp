@@ -28,14 +28,106 @@
 #include "March/PMUVoxelMap.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/StaticMeshSocket.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/LargeMemoryReader.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 
 #include "ProceduralMeshUtility.h"
 #include "PMUVoxelGrid.h"
+#include "March/PMUVoxelStencil.h"
 
 #ifdef PMU_VOXEL_USE_OCL
 #include "OCLBProgram.h"
 #endif
 
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelMap ~ Update Streaming"), STAT_PMUVoxelMap_UpdateStreaming, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelMap ~ Materialize Chunk"), STAT_PMUVoxelMap_MaterializeChunk, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelMap ~ Evict Chunk"), STAT_PMUVoxelMap_EvictChunk, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelMap ~ Save"), STAT_PMUVoxelMap_Save, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelMap ~ Load"), STAT_PMUVoxelMap_Load, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelMap ~ Decode Chunk"), STAT_PMUVoxelMap_DecodeChunk, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelMap ~ Weld Chunk Borders"), STAT_PMUVoxelMap_WeldChunkBorders, STATGROUP_ProceduralMeshUtility);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Materialized Chunks"), STAT_PMUVoxelMap_MaterializedChunks, STATGROUP_ProceduralMeshUtility);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Evicted Chunks"), STAT_PMUVoxelMap_EvictedChunks, STATGROUP_ProceduralMeshUtility);
+
+// Voxel map file layout:
+//
+//  uint32 magic, int32 version
+//  int32 map size, voxel resolution, chunk resolution, chunk count
+//  TArray<int64> chunk offsets, TArray<int32> chunk sizes
+//  chunk records, FPMUVoxelData compact serialization
+//
+// Chunk records of zero size denote chunks with reset states.
+// Version 1 chunk records store unquantized crossings.
+// Version 3 chunk records store a signed distance flag.
+
+enum { PMU_VOXEL_MAP_FILE_MAGIC = 0x564D5550 };
+enum { PMU_VOXEL_MAP_FILE_VERSION = FPMUVoxelData::VersionLatest };
+
+struct FPMUVoxelMapSource
+{
+    FString Filename;
+
+    // Region must be released before the handle, keep declaration order
+    TUniquePtr<IMappedFileHandle> MappedHandle;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+
+    // Fallback storage for platforms without mapped file support
+    TArray<uint8> FileData;
+
+    const uint8* Data = nullptr;
+    int64 DataSize = 0;
+
+    TArray<int64> ChunkOffsets;
+    TArray<int32> ChunkSizes;
+
+    int32 Version = 0;
+
+    bool Open(const FString& InFilename)
+    {
+        Filename = InFilename;
+
+        IPlatformFile& PlatformFile(FPlatformFileManager::Get().GetPlatformFile());
+
+        MappedHandle.Reset(PlatformFile.OpenMapped(*Filename));
+
+        if (MappedHandle.IsValid())
+        {
+            MappedRegion.Reset(MappedHandle->MapRegion());
+        }
+
+        if (MappedRegion.IsValid())
+        {
+            Data = MappedRegion->GetMappedPtr();
+            DataSize = MappedRegion->GetMappedSize();
+        }
+        else if (FFileHelper::LoadFileToArray(FileData, *Filename))
+        {
+            Data = FileData.GetData();
+            DataSize = FileData.Num();
+        }
+
+        return Data != nullptr;
+    }
+
+    FORCEINLINE bool HasChunkRecord(int32 i) const
+    {
+        return ChunkSizes.IsValidIndex(i) && ChunkSizes[i] > 0;
+    }
+
+    FORCEINLINE const uint8* GetChunkData(int32 i) const
+    {
+        return Data + ChunkOffsets[i];
+    }
+};
+
 static int32 GetNewIndexForOldVertIndex(
     int32 MeshVertIndex,
     TMap<int32, int32>& MeshToSectionVertMap,
@@ -105,9 +197,33 @@ const FPMUVoxelGrid& FPMUVoxelMap::GetChunk(int32 ChunkIndex) const
 
 void FPMUVoxelMap::RefreshAllChunks()
 {
-    for (FPMUVoxelGrid* Chunk : chunks)
+    if (bStreamChunks)
     {
-        Chunk->Refresh();
+        TArray<int32> ChunkIndices;
+
+        for (int32 i=0; i<chunks.Num(); ++i)
+        {
+            if (chunks[i]->IsResident())
+            {
+                ChunkIndices.Emplace(i);
+            }
+        }
+
+        for (int32 i : ChunkIndices)
+        {
+            FPMUVoxelGrid& Chunk(AcquireChunk(i));
+            Chunk.ClearDirty();
+            Chunk.Refresh();
+        }
+
+        return;
+    }
+
+    for (int32 i=0; i<chunks.Num(); ++i)
+    {
+        FPMUVoxelGrid& Chunk(AcquireChunk(i));
+        Chunk.ClearDirty();
+        Chunk.Refresh();
     }
 }
 
@@ -115,49 +231,964 @@ void FPMUVoxelMap::RefreshAllChunksAsync(FGWTAsyncTaskRef& TaskRef)
 {
     if (! TaskRef.IsValid())
     {
-        FGWTAsyncTaskRef::Init(
-            TaskRef,
-            IProceduralMeshUtility::Get().GetThreadPool());
+        FGWTAsyncTaskRef::Init(
+            TaskRef,
+            IProceduralMeshUtility::Get().GetThreadPool());
+    }
+
+    check(TaskRef.IsValid());
+
+    FPSGWTAsyncTask& Task(TaskRef.Task);
+
+    // Streamed chunk neighbours are materialized before any task is
+    // scheduled since chunk triangulation reads neighbour voxels
+
+    TArray<int32> ChunkIndices;
+
+    for (int32 i=0; i<chunks.Num(); ++i)
+    {
+        if (chunks[i]->IsResident() || ! bStreamChunks)
+        {
+            ChunkIndices.Emplace(i);
+        }
+    }
+
+    for (int32 i : ChunkIndices)
+    {
+        FPMUVoxelGrid& Chunk(AcquireChunk(i));
+        Chunk.ClearDirty();
+        Task->AddTask([&Chunk](){ Chunk.Refresh(); });
+    }
+}
+
+void FPMUVoxelMap::ResetChunkStates(const TArray<int32>& ChunkIndices)
+{
+    for (int32 i : ChunkIndices)
+    {
+        if (chunks.IsValidIndex(i))
+        {
+            // Evicted chunk records are discarded, the chunk would
+            // materialize with reset states on the next acquisition
+
+            if (HasLazyChunks())
+            {
+                FScopeLock Lock(&chunkLock);
+
+                if (evictedChunks[i])
+                {
+                    IFileManager::Get().Delete(*GetChunkStreamingPath(i));
+                    evictedChunks[i] = false;
+                }
+
+                mappedChunks[i] = false;
+            }
+
+            chunks[i]->ResetVoxels();
+            MarkChunkDirty(i % chunkResolution, i / chunkResolution);
+        }
+    }
+}
+
+void FPMUVoxelMap::ResetAllChunkStates()
+{
+    if (HasLazyChunks())
+    {
+        FScopeLock Lock(&chunkLock);
+
+        for (int32 i=0; i<chunks.Num(); ++i)
+        {
+            if (evictedChunks[i])
+            {
+                IFileManager::Get().Delete(*GetChunkStreamingPath(i));
+                evictedChunks[i] = false;
+            }
+        }
+
+        mappedChunks.Init(false, chunks.Num());
+        mapSource.Reset();
+    }
+
+    for (FPMUVoxelGrid* Chunk : chunks)
+    {
+        Chunk->ResetVoxels();
+    }
+
+    MarkAllChunksDirty();
+}
+
+bool FPMUVoxelMap::IsChunkDirty(int32 ChunkIndex) const
+{
+    return HasChunk(ChunkIndex) && chunks[ChunkIndex]->IsDirty();
+}
+
+void FPMUVoxelMap::MarkChunkDirty(int32 x, int32 y)
+{
+    check(x >= 0 && x < chunkResolution);
+    check(y >= 0 && y < chunkResolution);
+
+    // Mark the chunk itself along with its -x, -y and -xy neighbours,
+    // those chunks read the chunk voxels for their gap cells and gap rows
+
+    for (int32 cy=FMath::Max(0, y-1); cy<=y; ++cy)
+    for (int32 cx=FMath::Max(0, x-1); cx<=x; ++cx)
+    {
+        chunks[cx + cy*chunkResolution]->MarkDirty();
+    }
+}
+
+void FPMUVoxelMap::MarkAllChunksDirty()
+{
+    for (FPMUVoxelGrid* Chunk : chunks)
+    {
+        Chunk->MarkDirty();
+    }
+}
+
+void FPMUVoxelMap::GetDirtyChunks(TArray<int32>& OutChunkIndices) const
+{
+    OutChunkIndices.Reset();
+
+    // Non-resident chunks have no geometry to refresh
+
+    for (int32 i=0; i<chunks.Num(); ++i)
+    {
+        if (chunks[i]->IsDirty() && (chunks[i]->IsResident() || ! bStreamChunks))
+        {
+            OutChunkIndices.Emplace(i);
+        }
+    }
+}
+
+void FPMUVoxelMap::RefreshDirtyChunks(TArray<int32>& OutChunkIndices)
+{
+    GetDirtyChunks(OutChunkIndices);
+
+    for (int32 i : OutChunkIndices)
+    {
+        FPMUVoxelGrid& Chunk(AcquireChunk(i));
+        Chunk.ClearDirty();
+        Chunk.Refresh();
+    }
+}
+
+void FPMUVoxelMap::RefreshDirtyChunksAsync(FGWTAsyncTaskRef& TaskRef, TArray<int32>& OutChunkIndices)
+{
+    if (! TaskRef.IsValid())
+    {
+        FGWTAsyncTaskRef::Init(
+            TaskRef,
+            IProceduralMeshUtility::Get().GetThreadPool());
+    }
+
+    check(TaskRef.IsValid());
+
+    FPSGWTAsyncTask& Task(TaskRef.Task);
+
+    GetDirtyChunks(OutChunkIndices);
+
+    // Dirty flags are cleared on schedule so that edits made while
+    // the refresh tasks are running would mark the chunks dirty again
+
+    for (int32 i : OutChunkIndices)
+    {
+        FPMUVoxelGrid& Chunk(AcquireChunk(i));
+        Chunk.ClearDirty();
+        Task->AddTask([&Chunk](){ Chunk.Refresh(); });
+    }
+}
+
+void FPMUVoxelMap::ApplySimplifiedSections(TArray<int32>& OutChunkIndices)
+{
+    OutChunkIndices.Reset();
+
+    for (int32 i=0; i<chunks.Num(); ++i)
+    {
+        if (chunks[i]->ApplySimplifiedSections())
+        {
+            OutChunkIndices.Emplace(i);
+        }
+    }
+}
+
+int32 FPMUVoxelMap::GetPendingSimplificationCount() const
+{
+    int32 PendingCount = 0;
+
+    for (const FPMUVoxelGrid* Chunk : chunks)
+    {
+        PendingCount += Chunk->GetPendingSimplificationCount();
+    }
+
+    return PendingCount;
+}
+
+void FPMUVoxelMap::ShrinkChunkBuffers()
+{
+    for (FPMUVoxelGrid* Chunk : chunks)
+    {
+        Chunk->ShrinkBuffers();
+    }
+}
+
+int32 FPMUVoxelMap::GetBufferAllocationCount() const
+{
+    int32 AllocationCount = 0;
+
+    for (const FPMUVoxelGrid* Chunk : chunks)
+    {
+        AllocationCount += Chunk->GetBufferAllocationCount();
+    }
+
+    return AllocationCount;
+}
+
+// LOD FUNCTIONS
+
+int32 FPMUVoxelMap::SetChunkLOD(int32 ChunkIndex, int32 LODLevel)
+{
+    if (! HasChunk(ChunkIndex))
+    {
+        return 0;
+    }
+
+    FPMUVoxelGrid& Chunk(*chunks[ChunkIndex]);
+    const int32 prevLOD = Chunk.GetLODLevel();
+    const int32 appliedLOD = Chunk.SetLODLevel(LODLevel);
+
+    if (appliedLOD != prevLOD)
+    {
+        UpdateChunkNeighbourLODs(ChunkIndex);
+    }
+
+    return appliedLOD;
+}
+
+int32 FPMUVoxelMap::GetChunkLOD(int32 ChunkIndex) const
+{
+    return HasChunk(ChunkIndex) ? chunks[ChunkIndex]->GetLODLevel() : 0;
+}
+
+void FPMUVoxelMap::UpdateChunkBorderLODs(int32 x, int32 y)
+{
+    auto GetLOD = [this](int32 cx, int32 cy)
+    {
+        const bool bValid = cx >= 0 && cx < chunkResolution && cy >= 0 && cy < chunkResolution;
+        return bValid ? chunks[cx + cy*chunkResolution]->GetLODLevel() : 0;
+    };
+
+    FPMUVoxelGrid& Chunk(*chunks[x + y*chunkResolution]);
+
+    Chunk.SetBorderLOD(0, GetLOD(x-1, y));
+    Chunk.SetBorderLOD(1, GetLOD(x+1, y));
+    Chunk.SetBorderLOD(2, GetLOD(x, y-1));
+    Chunk.SetBorderLOD(3, GetLOD(x, y+1));
+}
+
+void FPMUVoxelMap::UpdateChunkNeighbourLODs(int32 ChunkIndex)
+{
+    const int32 x = ChunkIndex % chunkResolution;
+    const int32 y = ChunkIndex / chunkResolution;
+
+    UpdateChunkBorderLODs(x, y);
+
+    if (x > 0) UpdateChunkBorderLODs(x-1, y);
+    if (y > 0) UpdateChunkBorderLODs(x, y-1);
+    if (x < chunkResolution-1) UpdateChunkBorderLODs(x+1, y);
+    if (y < chunkResolution-1) UpdateChunkBorderLODs(x, y+1);
+}
+
+// BORDER WELDING FUNCTIONS
+
+enum EPMUVoxelWeldBorder : uint8
+{
+    WELD_BORDER_X_MIN = 1,
+    WELD_BORDER_X_MAX = 2,
+    WELD_BORDER_Y_MIN = 4,
+    WELD_BORDER_Y_MAX = 8
+};
+
+void FPMUVoxelMap::GetWeldChunkSet(const TArray<int32>& ChunkIndices, TArray<int32>& OutChunkIndices, TBitArray<>& OutChunkSet) const
+{
+    OutChunkIndices.Reset();
+    OutChunkSet.Init(false, chunks.Num());
+
+    auto AddChunk = [&](int32 i)
+    {
+        if (chunks.IsValidIndex(i) && ! OutChunkSet[i] && chunks[i]->IsResident())
+        {
+            OutChunkSet[i] = true;
+            OutChunkIndices.Emplace(i);
+        }
+    };
+
+    if (ChunkIndices.Num() > 0)
+    {
+        for (int32 i : ChunkIndices)
+        {
+            AddChunk(i);
+        }
+    }
+    else
+    {
+        for (int32 i=0; i<chunks.Num(); ++i)
+        {
+            AddChunk(i);
+        }
+    }
+}
+
+uint8 FPMUVoxelMap::GetWeldBorders(int32 ChunkIndex, const TBitArray<>& ChunkSet) const
+{
+    const FPMUVoxelGrid& Chunk(*chunks[ChunkIndex]);
+    const int32 x = ChunkIndex % chunkResolution;
+    const int32 y = ChunkIndex / chunkResolution;
+
+    uint8 Borders = 0;
+
+    if (x > 0 && ChunkSet[ChunkIndex-1])
+    {
+        Borders |= WELD_BORDER_X_MIN;
+    }
+
+    if (Chunk.xNeighbor && ChunkSet[ChunkIndex+1])
+    {
+        Borders |= WELD_BORDER_X_MAX;
+    }
+
+    if (y > 0 && ChunkSet[ChunkIndex-chunkResolution])
+    {
+        Borders |= WELD_BORDER_Y_MIN;
+    }
+
+    if (Chunk.yNeighbor && ChunkSet[ChunkIndex+chunkResolution])
+    {
+        Borders |= WELD_BORDER_Y_MAX;
+    }
+
+    return Borders;
+}
+
+bool FPMUVoxelMap::GetWeldKey(int32 ChunkIndex, uint8 Borders, const FPMUMeshVertex& Vertex, FIntVector& OutKey) const
+{
+    const FVector& Position(Vertex.Position);
+    const FVector2D& ChunkMin(chunks[ChunkIndex]->position);
+    const FVector2D ChunkMax(ChunkMin + FVector2D(chunkSize, chunkSize));
+    const float Tolerance = voxelSize * .01f;
+
+    const bool bOnXMin = FMath::IsNearlyEqual(Position.X, ChunkMin.X, Tolerance);
+    const bool bOnXMax = FMath::IsNearlyEqual(Position.X, ChunkMax.X, Tolerance);
+    const bool bOnYMin = FMath::IsNearlyEqual(Position.Y, ChunkMin.Y, Tolerance);
+    const bool bOnYMax = FMath::IsNearlyEqual(Position.Y, ChunkMax.Y, Tolerance);
+
+    const bool bOnBorder =
+        ((Borders & WELD_BORDER_X_MIN) && bOnXMin) ||
+        ((Borders & WELD_BORDER_X_MAX) && bOnXMax) ||
+        ((Borders & WELD_BORDER_Y_MIN) && bOnYMin) ||
+        ((Borders & WELD_BORDER_Y_MAX) && bOnYMax);
+
+    if (! bOnBorder)
+    {
+        return false;
+    }
+
+    // Border vertices are keyed by the chunk border line they lie on
+    // (map chunk boundary index, tagged with the line axis) and their
+    // quantized coordinate along the line. Chunk corners are keyed by
+    // boundary indices alone. Extrusion vertices share positions with
+    // their surface vertices and are told apart by the normal direction.
+
+    const int32 x = ChunkIndex % chunkResolution;
+    const int32 y = ChunkIndex / chunkResolution;
+    const int32 Layer = Vertex.Normal.Z < 0.f ? 1 : 0;
+
+    const bool bOnXLine = bOnXMin || bOnXMax;
+    const bool bOnYLine = bOnYMin || bOnYMax;
+
+    const int32 xLine = bOnXMax ? x+1 : x;
+    const int32 yLine = bOnYMax ? y+1 : y;
+
+    const float QuantizeScale = 1.f / Tolerance;
+
+    if (bOnXLine && bOnYLine)
+    {
+        OutKey = FIntVector(xLine*3 + 2, yLine, Layer);
+    }
+    else if (bOnXLine)
+    {
+        OutKey = FIntVector(xLine*3, FMath::RoundToInt(Position.Y * QuantizeScale), Layer);
+    }
+    else
+    {
+        OutKey = FIntVector(yLine*3 + 1, FMath::RoundToInt(Position.X * QuantizeScale), Layer);
+    }
+
+    return true;
+}
+
+// Coincident border vertices may round into adjacent quantization cells
+// along the border line, adjacent cells are probed if there is no match.
+// Chunk corner keys are exact.
+
+template<typename ValueType>
+static ValueType* FindWeldKey(TMap<FIntVector, ValueType>& WeldMap, const FIntVector& Key)
+{
+    ValueType* Value = WeldMap.Find(Key);
+
+    if (! Value && (Key.X % 3) != 2)
+    {
+        Value = WeldMap.Find(FIntVector(Key.X, Key.Y-1, Key.Z));
+
+        if (! Value)
+        {
+            Value = WeldMap.Find(FIntVector(Key.X, Key.Y+1, Key.Z));
+        }
+    }
+
+    return Value;
+}
+
+void FPMUVoxelMap::GetWeldedSection(const TArray<int32>& ChunkIndices, int32 StateIndex, FPMUMeshSection& OutSection, FPMUVoxelWeldStats& OutStats) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_PMUVoxelMap_WeldChunkBorders);
+
+    OutSection.ResetGeometry();
+    OutStats = FPMUVoxelWeldStats();
+
+    TArray<int32> WeldIndices;
+    TBitArray<> WeldSet;
+    GetWeldChunkSet(ChunkIndices, WeldIndices, WeldSet);
+
+    TMap<FIntVector, int32> WeldedVertices;
+    TArray<int32> VertexRemap;
+    bool bHasSectionSettings = false;
+
+    for (int32 i : WeldIndices)
+    {
+        const FPMUMeshSection* Section = chunks[i]->GetSection(StateIndex);
+
+        if (! Section || Section->GetVertexCount() < 1)
+        {
+            continue;
+        }
+
+        if (! bHasSectionSettings)
+        {
+            OutSection.bUsePositionAsUV = Section->bUsePositionAsUV;
+            OutSection.bEnableCollision = Section->bEnableCollision;
+            OutSection.bSectionVisible  = Section->bSectionVisible;
+            bHasSectionSettings = true;
+        }
+
+        const uint8 Borders = GetWeldBorders(i, WeldSet);
+        const int32 VertexCount = Section->GetVertexCount();
+
+        VertexRemap.SetNumUninitialized(VertexCount, false);
+
+        // Append vertices, border vertices already emitted by previous
+        // chunks are replaced with their welded vertex
+
+        for (int32 vi=0; vi<VertexCount; ++vi)
+        {
+            const FPMUMeshVertex& Vertex(Section->VertexBuffer[vi]);
+            FIntVector Key;
+
+            if (Borders && GetWeldKey(i, Borders, Vertex, Key))
+            {
+                if (const int32* WeldedIndex = FindWeldKey(WeldedVertices, Key))
+                {
+                    OutSection.VertexBuffer[*WeldedIndex].Normal += Vertex.Normal;
+                    VertexRemap[vi] = *WeldedIndex;
+                    ++OutStats.WeldedVertexCount;
+                    continue;
+                }
+
+                WeldedVertices.Emplace(Key, OutSection.VertexBuffer.Num());
+            }
+
+            VertexRemap[vi] = OutSection.VertexBuffer.Emplace(Vertex);
+        }
+
+        // Append remapped triangles, skip triangles collapsed by welding
+
+        const TArray<int32>& IndexBuffer(Section->IndexBuffer);
+
+        for (int32 ti=0; (ti+2)<IndexBuffer.Num(); ti+=3)
+        {
+            const int32 a = VertexRemap[IndexBuffer[ti  ]];
+            const int32 b = VertexRemap[IndexBuffer[ti+1]];
+            const int32 c = VertexRemap[IndexBuffer[ti+2]];
+
+            if (a != b && b != c && c != a)
+            {
+                OutSection.IndexBuffer.Emplace(a);
+                OutSection.IndexBuffer.Emplace(b);
+                OutSection.IndexBuffer.Emplace(c);
+            }
+        }
+
+        OutSection.LocalBox += Section->LocalBox;
+        OutStats.InputVertexCount += VertexCount;
+    }
+
+    // Welded normals are accumulated, normalize them
+
+    for (const TPair<FIntVector, int32>& WeldedVertex : WeldedVertices)
+    {
+        FVector& Normal(OutSection.VertexBuffer[WeldedVertex.Value].Normal);
+        Normal = Normal.GetSafeNormal();
+    }
+
+    OutStats.OutputVertexCount = OutSection.GetVertexCount();
+}
+
+void FPMUVoxelMap::WeldChunkBorderNormals(const TArray<int32>& ChunkIndices, int32 StateIndex, FPMUVoxelWeldStats& OutStats)
+{
+    SCOPE_CYCLE_COUNTER(STAT_PMUVoxelMap_WeldChunkBorders);
+
+    OutStats = FPMUVoxelWeldStats();
+
+    TArray<int32> WeldIndices;
+    TBitArray<> WeldSet;
+    GetWeldChunkSet(ChunkIndices, WeldIndices, WeldSet);
+
+    struct FWeldedNormal
+    {
+        FVector Normal;
+        int32 Count;
+    };
+
+    TMap<FIntVector, FWeldedNormal> WeldedNormals;
+
+    // Accumulate normals of coincident border vertices
+
+    for (int32 i : WeldIndices)
+    {
+        const FPMUMeshSection* Section = chunks[i]->GetSection(StateIndex);
+
+        if (! Section)
+        {
+            continue;
+        }
+
+        const uint8 Borders = GetWeldBorders(i, WeldSet);
+        OutStats.InputVertexCount += Section->GetVertexCount();
+
+        if (! Borders)
+        {
+            continue;
+        }
+
+        for (const FPMUMeshVertex& Vertex : Section->VertexBuffer)
+        {
+            FIntVector Key;
+
+            if (GetWeldKey(i, Borders, Vertex, Key))
+            {
+                FWeldedNormal* WeldedNormal = FindWeldKey(WeldedNormals, Key);
+
+                if (WeldedNormal)
+                {
+                    WeldedNormal->Normal += Vertex.Normal;
+                    WeldedNormal->Count += 1;
+                    ++OutStats.WeldedVertexCount;
+                }
+                else
+                {
+                    WeldedNormals.Emplace(Key, FWeldedNormal { Vertex.Normal, 1 });
+                }
+            }
+        }
+    }
+
+    OutStats.OutputVertexCount = OutStats.InputVertexCount - OutStats.WeldedVertexCount;
+
+    if (OutStats.WeldedVertexCount < 1)
+    {
+        return;
+    }
+
+    for (TPair<FIntVector, FWeldedNormal>& WeldedNormal : WeldedNormals)
+    {
+        WeldedNormal.Value.Normal = WeldedNormal.Value.Normal.GetSafeNormal();
+    }
+
+    // Write unified normals back to chunk sections
+
+    for (int32 i : WeldIndices)
+    {
+        const uint8 Borders = GetWeldBorders(i, WeldSet);
+
+        if (! Borders || ! chunks[i]->GetSection(StateIndex))
+        {
+            continue;
+        }
+
+        FPMUMeshSection* Section = AcquireChunk(i).GetMutableSection(StateIndex);
+
+        for (FPMUMeshVertex& Vertex : Section->VertexBuffer)
+        {
+            FIntVector Key;
+
+            if (GetWeldKey(i, Borders, Vertex, Key))
+            {
+                const FWeldedNormal* WeldedNormal = FindWeldKey(WeldedNormals, Key);
+                check(WeldedNormal != nullptr);
+
+                if (WeldedNormal->Count > 1)
+                {
+                    Vertex.Normal = WeldedNormal->Normal;
+                }
+            }
+        }
+    }
+}
+
+void FPMUVoxelMap::Clear()
+{
+    for (FPMUVoxelGrid* Chunk : chunks)
+    {
+        delete Chunk;
+    }
+
+    chunks.Empty();
+
+    ClearStreaming();
+}
+
+// STREAMING FUNCTIONS
+
+void FPMUVoxelMap::InitializeStreaming()
+{
+    const int32 chunkCount = chunks.Num();
+
+    chunkAccessTimes.SetNumZeroed(chunkCount);
+    evictedChunks.Init(false, chunkCount);
+    mappedChunks.Init(false, chunkCount);
+    accessClock = 0;
+    materializeCount = 0;
+    evictCount = 0;
+
+    // Each map instance streams into its own directory
+
+    if (bStreamChunks)
+    {
+        streamingDirectory = FPaths::Combine(
+            FPaths::ProjectSavedDir(),
+            TEXT("PMUVoxelStreaming"),
+            FGuid::NewGuid().ToString()
+            );
+    }
+}
+
+void FPMUVoxelMap::ClearStreaming()
+{
+    if (! streamingDirectory.IsEmpty())
+    {
+        IFileManager::Get().DeleteDirectory(*streamingDirectory, false, true);
+        streamingDirectory.Empty();
+    }
+
+    chunkAccessTimes.Empty();
+    evictedChunks.Empty();
+    mappedChunks.Empty();
+    mapSource.Reset();
+}
+
+FString FPMUVoxelMap::GetChunkStreamingPath(int32 i) const
+{
+    return FPaths::Combine(streamingDirectory, FString::Printf(TEXT("Chunk_%d.bin"), i));
+}
+
+bool FPMUVoxelMap::IsChunkResident(int32 ChunkIndex) const
+{
+    return HasChunk(ChunkIndex) && chunks[ChunkIndex]->IsResident();
+}
+
+FPMUVoxelGrid& FPMUVoxelMap::AcquireChunk(int32 ChunkIndex)
+{
+    check(chunks.IsValidIndex(ChunkIndex));
+
+    FPMUVoxelGrid& Chunk(*chunks[ChunkIndex]);
+
+    FScopeLock Lock(&chunkLock);
+
+    // Materialize the chunk along with its +x, +y and +xy neighbours,
+    // chunk crossings and gap cells read voxels from those neighbours
+
+    if (HasLazyChunks())
+    {
+        const int32 x = ChunkIndex % chunkResolution;
+        const int32 y = ChunkIndex / chunkResolution;
+
+        for (int32 cy=y; cy<=FMath::Min(y+1, chunkResolution-1); ++cy)
+        for (int32 cx=x; cx<=FMath::Min(x+1, chunkResolution-1); ++cx)
+        {
+            const int32 i = cx + cy*chunkResolution;
+            MaterializeChunk(i);
+            chunkAccessTimes[i] = ++accessClock;
+        }
+    }
+
+    // Acquired chunks are about to be modified, clone data still
+    // shared with map copies. Neighbours are only read and stay shared.
+
+    Chunk.DetachSharedData();
+
+    return Chunk;
+}
+
+void FPMUVoxelMap::MaterializeChunk(int32 i)
+{
+    FPMUVoxelGrid& Chunk(*chunks[i]);
+
+    if (Chunk.IsResident())
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_PMUVoxelMap_MaterializeChunk);
+
+    const int32 shellLOD = Chunk.GetLODLevel();
+
+    FPMUVoxelGridConfig ChunkConfig;
+    InitializeChunkSettings(i, i % chunkResolution, i / chunkResolution, ChunkConfig);
+    InitializeChunk(i, ChunkConfig);
+
+    // Restore evicted voxel data
+
+    if (evictedChunks[i])
+    {
+        const FString ChunkPath(GetChunkStreamingPath(i));
+        TArray<uint8> ChunkData;
+        bool bLoaded = false;
+
+        if (FFileHelper::LoadFileToArray(ChunkData, *ChunkPath))
+        {
+            FMemoryReader Ar(ChunkData);
+            bLoaded = DecodeChunk(i, Ar, PMU_VOXEL_MAP_FILE_VERSION);
+        }
+
+        ensureMsgf(bLoaded, TEXT("FPMUVoxelMap::MaterializeChunk() Failed to load chunk %d from %s"), i, *ChunkPath);
+
+        IFileManager::Get().Delete(*ChunkPath);
+        evictedChunks[i] = false;
+    }
+    // Decode chunk record from loaded map file
+    else if (mappedChunks[i])
+    {
+        check(mapSource.IsValid());
+
+        // Reader sets the archive error on overrun, truncated records
+        // fail validation instead of asserting
+        FLargeMemoryReader Ar(mapSource->GetChunkData(i), mapSource->ChunkSizes[i]);
+
+        const bool bLoaded = DecodeChunk(i, Ar, mapSource->Version);
+
+        ensureMsgf(bLoaded, TEXT("FPMUVoxelMap::MaterializeChunk() Failed to decode chunk %d from %s"), i, *mapSource->Filename);
+
+        mappedChunks[i] = false;
+    }
+
+    // Requested LOD is revalidated against the chunk voxel resolution
+    // on initialization, neighbours stitch against the applied level
+
+    if (Chunk.GetLODLevel() != shellLOD)
+    {
+        UpdateChunkNeighbourLODs(i);
+    }
+
+    Chunk.MarkDirty();
+
+    ++materializeCount;
+    INC_DWORD_STAT(STAT_PMUVoxelMap_MaterializedChunks);
+}
+
+bool FPMUVoxelMap::DecodeChunk(int32 i, FArchive& Ar, int32 Version)
+{
+    SCOPE_CYCLE_COUNTER(STAT_PMUVoxelMap_DecodeChunk);
+
+    FPMUVoxelGrid& Chunk(*chunks[i]);
+
+    // Record layout is validated against the chunk settings before any
+    // voxel allocation and record states against the map surface states,
+    // fallback to reset voxels on invalid chunk record
+
+    const bool bValidRecord = Chunk.SerializeVoxels(Ar, Version);
+
+    if (! bValidRecord || Chunk.voxels->voxelResolution != voxelResolution)
+    {
+        Chunk.voxels.Edit().Initialize(voxelResolution, voxelSize, bSignedDistance);
+        return false;
+    }
+
+    // Crossing records loaded into signed distance maps are converted,
+    // stencil edits do not write crossings on signed distance maps
+
+    if (bSignedDistance && ! Chunk.HasDistances())
+    {
+        Chunk.voxels.Edit().ConvertCrossingsToDistances();
+    }
+
+    return true;
+}
+
+void FPMUVoxelMap::EvictChunk(int32 i)
+{
+    SCOPE_CYCLE_COUNTER(STAT_PMUVoxelMap_EvictChunk);
+
+    FPMUVoxelGrid& Chunk(*chunks[i]);
+
+    check(Chunk.IsResident());
+
+    TArray<uint8> ChunkData;
+    FMemoryWriter Ar(ChunkData);
+    Chunk.SerializeVoxels(Ar);
+
+    IFileManager::Get().MakeDirectory(*streamingDirectory, true);
+
+    // Keep the chunk resident if its voxel data could not be written
+
+    if (! FFileHelper::SaveArrayToFile(ChunkData, *GetChunkStreamingPath(i)))
+    {
+        return;
+    }
+
+    Chunk.Evict();
+    evictedChunks[i] = true;
+
+    ++evictCount;
+    INC_DWORD_STAT(STAT_PMUVoxelMap_EvictedChunks);
+}
+
+void FPMUVoxelMap::UpdateStreaming(TArray<int32>& OutMaterializedChunks, TArray<int32>& OutEvictedChunks)
+{
+    OutMaterializedChunks.Reset();
+    OutEvictedChunks.Reset();
+
+    if (! bStreamChunks || chunks.Num() < 1)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_PMUVoxelMap_UpdateStreaming);
+
+    FScopeLock Lock(&chunkLock);
+
+    // Materialize and pin chunks within streaming radius of focus points
+
+    TBitArray<> pinnedChunks(false, chunks.Num());
+
+    const float radiusSq = streamingRadius * streamingRadius;
+
+    for (const FVector2D& Point : streamingFocusPoints)
+    {
+        const int32 x0 = FMath::Clamp(FMath::FloorToInt((Point.X-streamingRadius) / chunkSize), 0, chunkResolution-1);
+        const int32 x1 = FMath::Clamp(FMath::FloorToInt((Point.X+streamingRadius) / chunkSize), 0, chunkResolution-1);
+        const int32 y0 = FMath::Clamp(FMath::FloorToInt((Point.Y-streamingRadius) / chunkSize), 0, chunkResolution-1);
+        const int32 y1 = FMath::Clamp(FMath::FloorToInt((Point.Y+streamingRadius) / chunkSize), 0, chunkResolution-1);
+
+        for (int32 y=y0; y<=y1; ++y)
+        for (int32 x=x0; x<=x1; ++x)
+        {
+            const FVector2D ChunkMin(x * chunkSize, y * chunkSize);
+            const FBox2D ChunkBounds(ChunkMin, ChunkMin + chunkSize);
+
+            if (ChunkBounds.ComputeSquaredDistanceToPoint(Point) > radiusSq)
+            {
+                continue;
+            }
+
+            for (int32 cy=y; cy<=FMath::Min(y+1, chunkResolution-1); ++cy)
+            for (int32 cx=x; cx<=FMath::Min(x+1, chunkResolution-1); ++cx)
+            {
+                const int32 i = cx + cy*chunkResolution;
+
+                if (! chunks[i]->IsResident())
+                {
+                    MaterializeChunk(i);
+                    OutMaterializedChunks.Emplace(i);
+                }
+
+                pinnedChunks[i] = true;
+                chunkAccessTimes[i] = ++accessClock;
+            }
+        }
+    }
+
+    if (streamingMemoryBudget <= 0)
+    {
+        return;
     }
 
-    check(TaskRef.IsValid());
+    // Evict least recently used unpinned chunks until within budget
 
-    FPSGWTAsyncTask& Task(TaskRef.Task);
+    int64 residentBytes = 0;
+    TArray<int32> evictionCandidates;
 
     for (int32 i=0; i<chunks.Num(); ++i)
     {
-        FPMUVoxelGrid& Chunk(*chunks[i]);
-        Task->AddTask([&, i](){ Chunk.Refresh(); });
+        if (chunks[i]->IsResident())
+        {
+            residentBytes += chunks[i]->GetAllocatedSize();
+
+            if (! pinnedChunks[i])
+            {
+                evictionCandidates.Emplace(i);
+            }
+        }
     }
-}
 
-void FPMUVoxelMap::ResetChunkStates(const TArray<int32>& ChunkIndices)
-{
-    for (int32 i : ChunkIndices)
+    evictionCandidates.Sort(
+        [this](int32 a, int32 b)
+        {
+            return chunkAccessTimes[a] < chunkAccessTimes[b];
+        } );
+
+    for (int32 i : evictionCandidates)
     {
-        if (chunks.IsValidIndex(i))
+        if (residentBytes <= streamingMemoryBudget)
         {
-            chunks[i]->ResetVoxels();
+            break;
         }
-    }
-}
 
-void FPMUVoxelMap::ResetAllChunkStates()
-{
-    for (FPMUVoxelGrid* Chunk : chunks)
-    {
-        Chunk->ResetVoxels();
+        const int64 chunkBytes = chunks[i]->GetAllocatedSize();
+
+        EvictChunk(i);
+
+        if (! chunks[i]->IsResident())
+        {
+            residentBytes -= chunkBytes;
+            OutEvictedChunks.Emplace(i);
+        }
     }
 }
 
-void FPMUVoxelMap::Clear()
+void FPMUVoxelMap::GetResidencyStats(FPMUVoxelMapResidencyStats& OutStats) const
 {
-    for (FPMUVoxelGrid* Chunk : chunks)
+    FScopeLock Lock(&chunkLock);
+
+    int64 residentBytes = 0;
+
+    OutStats = FPMUVoxelMapResidencyStats();
+    OutStats.ChunkCount = chunks.Num();
+
+    for (int32 i=0; i<chunks.Num(); ++i)
     {
-        delete Chunk;
+        if (chunks[i]->IsResident())
+        {
+            residentBytes += chunks[i]->GetAllocatedSize();
+            ++OutStats.ResidentChunkCount;
+        }
+        else if (evictedChunks.IsValidIndex(i) && evictedChunks[i])
+        {
+            ++OutStats.EvictedChunkCount;
+        }
     }
 
-    chunks.Empty();
+    OutStats.ResidentMemoryMB = residentBytes / (1024.f * 1024.f);
+    OutStats.MemoryBudgetMB = streamingMemoryBudget / (1024.f * 1024.f);
+    OutStats.MaterializeCount = materializeCount;
+    OutStats.EvictCount = evictCount;
 }
 
 TSharedPtr<FGWTAsyncThreadPool> FPMUVoxelMap::GetThreadPool()
@@ -186,6 +1217,10 @@ void FPMUVoxelMap::InitializeSettings()
     chunkSize = mapSize / chunkResolution;
     voxelSize = chunkSize / voxelResolution;
 
+    simplifyThreadPool = bDeferSimplification
+        ? IProceduralMeshUtility::Get().GetBackgroundThreadPool()
+        : nullptr;
+
     if (GridData)
     {
         const FIntPoint& GridDim(GridData->Dimension);
@@ -206,6 +1241,8 @@ void FPMUVoxelMap::InitializeSettings()
     {
         chunks[i] = new FPMUVoxelGrid;
     }
+
+    InitializeStreaming();
 }
 
 void FPMUVoxelMap::InitializeChunkSettings(int32 i, int32 x, int32 y, FPMUVoxelGridConfig& ChunkConfig)
@@ -224,6 +1261,9 @@ void FPMUVoxelMap::InitializeChunkSettings(int32 i, int32 x, int32 y, FPMUVoxelG
     ChunkConfig.MaxFeatureAngle = maxFeatureAngle;
     ChunkConfig.MaxParallelAngle = maxParallelAngle;
     ChunkConfig.ExtrusionHeight = extrusionHeight;
+    ChunkConfig.TriangulationBands = triangulationBands;
+    ChunkConfig.bSignedDistance = bSignedDistance;
+    ChunkConfig.SimplifyThreadPool = simplifyThreadPool;
     ChunkConfig.GridData = bHasGridData ? GridData : nullptr;
 
 #ifdef PMU_VOXEL_USE_OCL
@@ -276,6 +1316,15 @@ void FPMUVoxelMap::InitializeChunks()
     {
         FPMUVoxelGridConfig ChunkConfig;
         InitializeChunkSettings(i, x, y, ChunkConfig);
+
+        // Streamed and mapped chunks are materialized on acquisition
+
+        if (bStreamChunks || mappedChunks[i])
+        {
+            chunks[i]->position = ChunkConfig.Position;
+            continue;
+        }
+
         InitializeChunk(i, ChunkConfig);
     }
 }
@@ -289,6 +1338,13 @@ void FPMUVoxelMap::InitializeChunksAsync(FGWTAsyncTaskRef& TaskRef)
     {
         FPMUVoxelGridConfig ChunkConfig;
         InitializeChunkSettings(i, x, y, ChunkConfig);
+
+        if (bStreamChunks || mappedChunks[i])
+        {
+            chunks[i]->position = ChunkConfig.Position;
+            continue;
+        }
+
         InitializeChunkAsync(i, ChunkConfig, TaskRef);
     }
 }
@@ -319,6 +1375,8 @@ void FPMUVoxelMap::CopyFrom(const FPMUVoxelMap& VoxelMap)
     chunkSize = VoxelMap.chunkSize;
     voxelSize = VoxelMap.voxelSize;
     bHasGridData = VoxelMap.bHasGridData;
+    simplifyThreadPool = VoxelMap.simplifyThreadPool;
+    streamingFocusPoints = VoxelMap.streamingFocusPoints;
 
 #ifdef PMU_VOXEL_USE_OCL
 
@@ -327,7 +1385,8 @@ void FPMUVoxelMap::CopyFrom(const FPMUVoxelMap& VoxelMap)
 
 #endif
 
-    // Create uninitialized chunks
+    // Create uninitialized chunks. Chunk copies share voxels
+    // and renderers with the source chunks until either is modified.
 
     Clear();
 
@@ -359,6 +1418,266 @@ void FPMUVoxelMap::CopyFrom(const FPMUVoxelMap& VoxelMap)
             }
         }
     }
+
+    // Copy streaming state, evicted chunk records are duplicated
+    // so that both maps could materialize their chunks independently
+
+    InitializeStreaming();
+
+    // Map sources are read-only and shared between copies
+
+    mapSource = VoxelMap.mapSource;
+    mappedChunks = VoxelMap.mappedChunks;
+
+    if (bStreamChunks && VoxelMap.bStreamChunks)
+    {
+        FScopeLock Lock(&VoxelMap.chunkLock);
+
+        chunkAccessTimes = VoxelMap.chunkAccessTimes;
+        accessClock = VoxelMap.accessClock;
+
+        for (int32 i=0; i<chunks.Num(); ++i)
+        {
+            if (VoxelMap.evictedChunks[i])
+            {
+                const FString ChunkPath(GetChunkStreamingPath(i));
+
+                IFileManager::Get().MakeDirectory(*streamingDirectory, true);
+
+                evictedChunks[i] = IFileManager::Get().Copy(
+                    *ChunkPath,
+                    *VoxelMap.GetChunkStreamingPath(i)
+                    ) == COPY_OK;
+            }
+        }
+    }
+}
+
+bool FPMUVoxelMap::Save(const FString& Filename)
+{
+    SCOPE_CYCLE_COUNTER(STAT_PMUVoxelMap_Save);
+
+    if (chunks.Num() < 1)
+    {
+        return false;
+    }
+
+    FScopeLock Lock(&chunkLock);
+
+    // Release the map source if it is about to be overwritten
+
+    if (mapSource.IsValid() && FPaths::IsSamePath(Filename, mapSource->Filename))
+    {
+        for (int32 i=0; i<chunks.Num(); ++i)
+        {
+            if (mappedChunks[i])
+            {
+                MaterializeChunk(i);
+            }
+        }
+
+        mapSource.Reset();
+    }
+
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Filename));
+
+    if (! Writer.IsValid())
+    {
+        UE_LOG(LogPMU,Warning, TEXT("FPMUVoxelMap::Save() Unable to open %s for writing"), *Filename);
+        return false;
+    }
+
+    FArchive& Ar(*Writer);
+
+    uint32 magic = PMU_VOXEL_MAP_FILE_MAGIC;
+    int32 version = PMU_VOXEL_MAP_FILE_VERSION;
+    int32 chunkCount = chunks.Num();
+
+    Ar << magic;
+    Ar << version;
+    Ar << mapSize;
+    Ar << voxelResolution;
+    Ar << chunkResolution;
+    Ar << chunkCount;
+
+    // Write placeholder chunk table, rewritten once chunk sizes are known
+
+    TArray<int64> chunkOffsets;
+    TArray<int32> chunkSizes;
+
+    chunkOffsets.SetNumZeroed(chunkCount);
+    chunkSizes.SetNumZeroed(chunkCount);
+
+    const int64 tableOffset = Ar.Tell();
+
+    Ar << chunkOffsets;
+    Ar << chunkSizes;
+
+    for (int32 i=0; i<chunkCount; ++i)
+    {
+        FPMUVoxelGrid& Chunk(*chunks[i]);
+
+        chunkOffsets[i] = Ar.Tell();
+
+        // Evicted and mapped chunk records share the chunk encoding
+        // and are written as is. Mapped records of older file versions
+        // are decoded and written with the current encoding.
+
+        if (mappedChunks[i] && mapSource->Version != PMU_VOXEL_MAP_FILE_VERSION)
+        {
+            MaterializeChunk(i);
+        }
+
+        if (Chunk.IsResident())
+        {
+            Chunk.SerializeVoxels(Ar);
+        }
+        else if (evictedChunks[i])
+        {
+            TArray<uint8> ChunkData;
+
+            if (FFileHelper::LoadFileToArray(ChunkData, *GetChunkStreamingPath(i)))
+            {
+                Ar.Serialize(ChunkData.GetData(), ChunkData.Num());
+            }
+        }
+        else if (mappedChunks[i])
+        {
+            Ar.Serialize(
+                const_cast<uint8*>(mapSource->GetChunkData(i)),
+                mapSource->ChunkSizes[i]
+                );
+        }
+
+        chunkSizes[i] = static_cast<int32>(Ar.Tell() - chunkOffsets[i]);
+    }
+
+    Ar.Seek(tableOffset);
+    Ar << chunkOffsets;
+    Ar << chunkSizes;
+
+    const bool bSuccess = ! Ar.IsError();
+
+    return Writer->Close() && bSuccess;
+}
+
+bool FPMUVoxelMap::Load(const FString& Filename)
+{
+    SCOPE_CYCLE_COUNTER(STAT_PMUVoxelMap_Load);
+
+    TSharedPtr<FPMUVoxelMapSource> Source(MakeShareable(new FPMUVoxelMapSource));
+
+    if (! Source->Open(Filename))
+    {
+        UE_LOG(LogPMU,Warning, TEXT("FPMUVoxelMap::Load() Unable to open %s"), *Filename);
+        return false;
+    }
+
+    // Read file header and chunk table only, chunk records are decoded
+    // from the mapped file on chunk acquisition
+
+    FLargeMemoryReader Ar(Source->Data, Source->DataSize);
+
+    uint32 magic = 0;
+    int32 version = 0;
+    int32 inMapSize = 0;
+    int32 inVoxelResolution = 0;
+    int32 inChunkResolution = 0;
+    int32 chunkCount = 0;
+
+    Ar << magic;
+    Ar << version;
+
+    if (Ar.IsError() || magic != PMU_VOXEL_MAP_FILE_MAGIC || version < 1 || version > PMU_VOXEL_MAP_FILE_VERSION)
+    {
+        UE_LOG(LogPMU,Warning, TEXT("FPMUVoxelMap::Load() %s is not a supported voxel map file"), *Filename);
+        return false;
+    }
+
+    Source->Version = version;
+
+    Ar << inMapSize;
+    Ar << inVoxelResolution;
+    Ar << inChunkResolution;
+    Ar << chunkCount;
+
+    bool bValidHeader = ! Ar.IsError()
+        && inMapSize > 0
+        && inVoxelResolution > 0
+        && inChunkResolution > 0
+        && chunkCount == ((int64)inChunkResolution * inChunkResolution);
+
+    // Chunk table is read as exactly chunk count elements once the file
+    // is known to hold them, stored table counts are only validated
+
+    if (bValidHeader)
+    {
+        const int64 tableSize = 2*sizeof(int32) + (int64)chunkCount * (sizeof(int64) + sizeof(int32));
+        bValidHeader = tableSize <= (Source->DataSize - Ar.Tell());
+    }
+
+    if (bValidHeader)
+    {
+        int32 offsetCount = 0;
+        int32 sizeCount = 0;
+
+        Source->ChunkOffsets.SetNumUninitialized(chunkCount);
+        Source->ChunkSizes.SetNumUninitialized(chunkCount);
+
+        Ar << offsetCount;
+
+        for (int32 i=0; i<chunkCount; ++i)
+        {
+            Ar << Source->ChunkOffsets[i];
+        }
+
+        Ar << sizeCount;
+
+        for (int32 i=0; i<chunkCount; ++i)
+        {
+            Ar << Source->ChunkSizes[i];
+        }
+
+        bValidHeader = ! Ar.IsError()
+            && offsetCount == chunkCount
+            && sizeCount == chunkCount;
+    }
+
+    for (int32 i=0; bValidHeader && i<chunkCount; ++i)
+    {
+        const int64 chunkOffset = Source->ChunkOffsets[i];
+        const int32 chunkBytes = Source->ChunkSizes[i];
+
+        bValidHeader = chunkOffset >= 0 && chunkBytes >= 0 && (chunkOffset + chunkBytes) <= Source->DataSize;
+    }
+
+    if (! bValidHeader)
+    {
+        UE_LOG(LogPMU,Warning, TEXT("FPMUVoxelMap::Load() %s has invalid header"), *Filename);
+        return false;
+    }
+
+    mapSize = inMapSize;
+    voxelResolution = inVoxelResolution;
+    chunkResolution = inChunkResolution;
+
+    InitializeSettings();
+
+    if (chunks.Num() != chunkCount)
+    {
+        return false;
+    }
+
+    mapSource = Source;
+
+    for (int32 i=0; i<chunkCount; ++i)
+    {
+        mappedChunks[i] = Source->HasChunkRecord(i);
+    }
+
+    InitializeChunks();
+
+    return true;
 }
 
 bool FPMUVoxelMap::IsPrefabValid(int32 PrefabIndex, int32 LODIndex, int32 SectionIndex) const
@@ -679,10 +1998,17 @@ void UPMUVoxelMapRef::ApplyMapSettings()
 
     VoxelMap.maxFeatureAngle = MaxFeatureAngle;
     VoxelMap.maxParallelAngle = MaxParallelAngle;
+    VoxelMap.triangulationBands = TriangulationBands;
+    VoxelMap.bDeferSimplification = bDeferSimplification;
+    VoxelMap.bSignedDistance = bSignedDistance;
 
     VoxelMap.surfaceStates = SurfaceStates;
     VoxelMap.meshPrefabs = MeshPrefabs;
 
+    VoxelMap.bStreamChunks = bStreamChunks;
+    VoxelMap.streamingMemoryBudget = static_cast<int64>(StreamingMemoryBudgetMB * 1024.f * 1024.f);
+    VoxelMap.streamingRadius = StreamingRadius;
+
     if (GridData)
     {
         VoxelMap.GridData = &GridData->GridData;
@@ -764,6 +2090,59 @@ void UPMUVoxelMapRef::EditMapAsync(FGWTAsyncTaskRef& TaskRef, const TArray<UPMUV
     }
 }
 
+void UPMUVoxelMapRef::EditMapBatched(const TArray<UPMUVoxelStencilRef*>& Stencils)
+{
+    if (! IsInitialized())
+    {
+        return;
+    }
+
+    TArray<FPMUVoxelStencilInstance> Instances;
+
+    for (UPMUVoxelStencilRef* Stencil : Stencils)
+    {
+        if (IsValid(Stencil))
+        {
+            Stencil->GetStencilInstances(Instances);
+        }
+    }
+
+    FPMUVoxelStencil::EditMapBatched(VoxelMap, Instances);
+}
+
+void UPMUVoxelMapRef::EditMapBatchedAsync(FGWTAsyncTaskRef& TaskRef, const TArray<UPMUVoxelStencilRef*>& Stencils)
+{
+    if (! TaskRef.IsValid())
+    {
+        FGWTAsyncTaskRef::Init(
+            TaskRef,
+            IProceduralMeshUtility::Get().GetThreadPool());
+    }
+
+    check(TaskRef.IsValid());
+
+    FPSGWTAsyncTask& Task(TaskRef.Task);
+
+    TArray<FPMUVoxelStencilInstance> Instances;
+
+    for (UPMUVoxelStencilRef* Stencil : Stencils)
+    {
+        if (IsValid(Stencil))
+        {
+            Stencil->GetStencilInstances(Instances);
+        }
+    }
+
+    // Chunk tasks are dispatched by the batched edit itself,
+    // a single pool task keeps the state and crossing passes ordered
+
+    Task->AddTask(
+        [this, Instances]()
+        {
+            FPMUVoxelStencil::EditMapBatched(VoxelMap, Instances);
+        } );
+}
+
 void UPMUVoxelMapRef::EditStatesAsync(FGWTAsyncTaskRef& TaskRef, const TArray<UPMUVoxelStencilRef*>& Stencils)
 {
     if (! TaskRef.IsValid())
@@ -844,7 +2223,13 @@ UPMUVoxelMapRef* UPMUVoxelMapRef::Copy(UObject* Outer) const
 	MapCopy->ExtrusionHeight = ExtrusionHeight;
 	MapCopy->MaxFeatureAngle = MaxFeatureAngle;
 	MapCopy->MaxParallelAngle = MaxParallelAngle;
+	MapCopy->TriangulationBands = TriangulationBands;
+	MapCopy->bDeferSimplification = bDeferSimplification;
+	MapCopy->bSignedDistance = bSignedDistance;
     MapCopy->MeshPrefabs = MeshPrefabs;
+    MapCopy->bStreamChunks = bStreamChunks;
+    MapCopy->StreamingMemoryBudgetMB = StreamingMemoryBudgetMB;
+    MapCopy->StreamingRadius = StreamingRadius;
 
 #ifdef PMU_VOXEL_USE_OCL
 
@@ -865,6 +2250,36 @@ UPMUVoxelMapRef* UPMUVoxelMapRef::Copy(UObject* Outer) const
     return MapCopy;
 }
 
+bool UPMUVoxelMapRef::SaveVoxelMap(const FString& Filename)
+{
+    return IsInitialized() ? VoxelMap.Save(Filename) : false;
+}
+
+bool UPMUVoxelMapRef::LoadVoxelMap(const FString& Filename)
+{
+    ApplyMapSettings();
+
+    // Map dimensions are defined by the loaded map file
+
+    if (VoxelMap.Load(Filename))
+    {
+        MapSize = VoxelMap.mapSize;
+        VoxelResolution = VoxelMap.voxelResolution;
+        ChunkResolution = VoxelMap.chunkResolution;
+        return true;
+    }
+
+    return false;
+}
+
+void UPMUVoxelMapRef::UpdateStreaming(TArray<int32>& OutMaterializedChunks, TArray<int32>& OutEvictedChunks)
+{
+    if (IsInitialized())
+    {
+        VoxelMap.UpdateStreaming(OutMaterializedChunks, OutEvictedChunks);
+    }
+}
+
 void UPMUVoxelMapRef::ResetChunkStates(const TArray<int32>& ChunkIndices)
 {
     if (IsInitialized())
@@ -901,6 +2316,30 @@ FPMUMeshSection UPMUVoxelMapRef::GetSection(int32 ChunkIndex, int32 StateIndex)
     return FPMUMeshSection();
 }
 
+FPMUMeshSection UPMUVoxelMapRef::GetWeldedSection(const TArray<int32>& ChunkIndices, int32 StateIndex, FPMUVoxelWeldStats& OutStats) const
+{
+    FPMUMeshSection Section;
+
+    if (IsInitialized())
+    {
+        VoxelMap.GetWeldedSection(ChunkIndices, StateIndex, Section, OutStats);
+    }
+
+    return Section;
+}
+
+FPMUVoxelWeldStats UPMUVoxelMapRef::WeldChunkBorderNormals(const TArray<int32>& ChunkIndices, int32 StateIndex)
+{
+    FPMUVoxelWeldStats Stats;
+
+    if (IsInitialized())
+    {
+        VoxelMap.WeldChunkBorderNormals(ChunkIndices, StateIndex, Stats);
+    }
+
+    return Stats;
+}
+
 // PREFAB FUNCTIONS
 
 TArray<FBox2D> UPMUVoxelMapRef::GetPrefabBounds(int32 PrefabIndex) const
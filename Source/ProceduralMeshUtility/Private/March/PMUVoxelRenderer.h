@@ -49,6 +49,17 @@ public:
         Initialize(Config);
     }
 
+    FPMUVoxelRenderer(const FPMUVoxelRenderer& Renderer)
+    {
+        CopyFrom(Renderer);
+    }
+
+    FPMUVoxelRenderer& operator=(const FPMUVoxelRenderer& Renderer)
+    {
+        CopyFrom(Renderer);
+        return *this;
+    }
+
     void Initialize(const FPMUVoxelSurfaceConfig& Config)
     {
         surface.Initialize(Config);
@@ -63,12 +74,22 @@ public:
     {
 		surface.Clear();
 	}
+
+    void InitializeRowCaches()
+    {
+        surface.InitializeRowCaches();
+    }
 	
 	void Apply()
     {
 		surface.Apply();
 	}
 
+    void ShrinkBuffers()
+    {
+        surface.ShrinkBuffers();
+    }
+
     FORCEINLINE FPMUVoxelSurface& GetSurface()
     {
         return surface;
@@ -89,45 +110,45 @@ public:
 		surface.PrepareCacheForNextRow();
 	}
 	
-	FORCEINLINE void CacheFirstCorner(const FPMUVoxel& voxel)
+	FORCEINLINE int32 CacheFirstCorner(const FVector2D& corner)
     {
-		surface.CacheFirstCorner(voxel);
+		return surface.CacheFirstCorner(corner);
 	}
 	
-	FORCEINLINE void CacheNextCorner(int32 i, const FPMUVoxel& voxel)
+	FORCEINLINE int32 CacheNextCorner(int32 i, const FVector2D& corner)
     {
-		surface.CacheNextCorner(i, voxel);
+		return surface.CacheNextCorner(i, corner);
 	}
 	
-	FORCEINLINE void CacheXEdge(int32 i, const FPMUVoxel& voxel)
+	FORCEINLINE void CacheXEdge(int32 i, const FVector2D& edgePoint)
     {
-		surface.CacheXEdge(i, voxel);
+		surface.CacheXEdge(i, edgePoint);
 	}
 	
-	FORCEINLINE void CacheXEdgeWithWall(int32 i, const FPMUVoxel& voxel)
+	FORCEINLINE void CacheXEdgeWithWall(int32 i, const FVector2D& edgePoint)
     {
-		surface.CacheXEdge(i, voxel);
+		surface.CacheXEdge(i, edgePoint);
 	}
 	
-	FORCEINLINE void CacheYEdge(const FPMUVoxel& voxel)
+	FORCEINLINE void CacheYEdge(const FVector2D& edgePoint)
     {
-		surface.CacheYEdge(voxel);
+		surface.CacheYEdge(edgePoint);
 	}
 	
-	FORCEINLINE void CacheYEdgeWithWall(const FPMUVoxel& voxel)
+	FORCEINLINE void CacheYEdgeWithWall(const FVector2D& edgePoint)
     {
-		surface.CacheYEdge(voxel);
+		surface.CacheYEdge(edgePoint);
 	}
 
 	void FillA(const FPMUVoxelCell& cell, const FPMUVoxelFeaturePoint& f)
     {
 		if (f.exists)
         {
-			surface.AddQuadA(cell.i, f.position, !cell.c.IsFilled(), !cell.b.IsFilled());
+			surface.AddQuadA(cell.i, f.position, !cell.c->IsFilled(), !cell.b->IsFilled());
 		}
         else
         {
-			surface.AddTriangleA(cell.i, !cell.b.IsFilled());
+			surface.AddTriangleA(cell.i, !cell.b->IsFilled());
 		}
 	}
 
@@ -135,11 +156,11 @@ public:
     {
 		if (f.exists)
         {
-			surface.AddQuadB(cell.i, f.position, !cell.a.IsFilled(), !cell.d.IsFilled());
+			surface.AddQuadB(cell.i, f.position, !cell.a->IsFilled(), !cell.d->IsFilled());
 		}
         else
         {
-			surface.AddTriangleB(cell.i, !cell.a.IsFilled());
+			surface.AddTriangleB(cell.i, !cell.a->IsFilled());
 		}
 	}
 	
@@ -147,11 +168,11 @@ public:
     {
 		if (f.exists)
         {
-			surface.AddQuadC(cell.i, f.position, !cell.d.IsFilled(), !cell.a.IsFilled());
+			surface.AddQuadC(cell.i, f.position, !cell.d->IsFilled(), !cell.a->IsFilled());
 		}
         else
         {
-			surface.AddTriangleC(cell.i, !cell.a.IsFilled());
+			surface.AddTriangleC(cell.i, !cell.a->IsFilled());
 		}
 	}
 	
@@ -159,11 +180,11 @@ public:
     {
 		if (f.exists)
         {
-			surface.AddQuadD(cell.i, f.position, !cell.b.IsFilled(), !cell.c.IsFilled());
+			surface.AddQuadD(cell.i, f.position, !cell.b->IsFilled(), !cell.c->IsFilled());
 		}
         else
         {
-			surface.AddTriangleD(cell.i, !cell.b.IsFilled());
+			surface.AddTriangleD(cell.i, !cell.b->IsFilled());
 		}
 	}
 
@@ -171,11 +192,11 @@ public:
     {
 		if (f.exists)
         {
-			surface.AddHexagonABC(cell.i, f.position, !cell.d.IsFilled());
+			surface.AddHexagonABC(cell.i, f.position, !cell.d->IsFilled());
 		}
         else
         {
-			surface.AddPentagonABC(cell.i, !cell.d.IsFilled());
+			surface.AddPentagonABC(cell.i, !cell.d->IsFilled());
 		}
 	}
 	
@@ -183,11 +204,11 @@ public:
     {
 		if (f.exists)
         {
-			surface.AddHexagonABD(cell.i, f.position, !cell.c.IsFilled());
+			surface.AddHexagonABD(cell.i, f.position, !cell.c->IsFilled());
 		}
         else
         {
-			surface.AddPentagonABD(cell.i, !cell.c.IsFilled());
+			surface.AddPentagonABD(cell.i, !cell.c->IsFilled());
 		}
 	}
 	
@@ -195,11 +216,11 @@ public:
     {
 		if (f.exists)
         {
-			surface.AddHexagonACD(cell.i, f.position, !cell.b.IsFilled());
+			surface.AddHexagonACD(cell.i, f.position, !cell.b->IsFilled());
 		}
         else
         {
-			surface.AddPentagonACD(cell.i, !cell.b.IsFilled());
+			surface.AddPentagonACD(cell.i, !cell.b->IsFilled());
 		}
 	}
 	
@@ -207,11 +228,11 @@ public:
     {
 		if (f.exists)
         {
-			surface.AddHexagonBCD(cell.i, f.position, !cell.a.IsFilled());
+			surface.AddHexagonBCD(cell.i, f.position, !cell.a->IsFilled());
 		}
         else
         {
-			surface.AddPentagonBCD(cell.i, !cell.a.IsFilled());
+			surface.AddPentagonBCD(cell.i, !cell.a->IsFilled());
 		}
 	}
 
@@ -219,11 +240,11 @@ public:
     {
 		if (f.exists)
         {
-			surface.AddPentagonAB(cell.i, f.position, !cell.c.IsFilled(), !cell.d.IsFilled());
+			surface.AddPentagonAB(cell.i, f.position, !cell.c->IsFilled(), !cell.d->IsFilled());
 		}
         else
         {
-			surface.AddQuadAB(cell.i, !cell.c.IsFilled());
+			surface.AddQuadAB(cell.i, !cell.c->IsFilled());
 		}
 	}
 	
@@ -231,11 +252,11 @@ public:
     {
 		if (f.exists)
         {
-			surface.AddPentagonAC(cell.i, f.position, !cell.d.IsFilled(), !cell.b.IsFilled());
+			surface.AddPentagonAC(cell.i, f.position, !cell.d->IsFilled(), !cell.b->IsFilled());
 		}
         else
         {
-			surface.AddQuadAC(cell.i, !cell.b.IsFilled());
+			surface.AddQuadAC(cell.i, !cell.b->IsFilled());
 		}
 	}
 	
@@ -243,11 +264,11 @@ public:
     {
 		if (f.exists)
         {
-			surface.AddPentagonBD(cell.i, f.position, !cell.a.IsFilled(), !cell.c.IsFilled());
+			surface.AddPentagonBD(cell.i, f.position, !cell.a->IsFilled(), !cell.c->IsFilled());
 		}
         else
         {
-			surface.AddQuadBD(cell.i, !cell.a.IsFilled());
+			surface.AddQuadBD(cell.i, !cell.a->IsFilled());
 		}
 	}
 	
@@ -255,11 +276,11 @@ public:
     {
 		if (f.exists)
         {
-			surface.AddPentagonCD(cell.i, f.position, !cell.b.IsFilled(), !cell.a.IsFilled());
+			surface.AddPentagonCD(cell.i, f.position, !cell.b->IsFilled(), !cell.a->IsFilled());
 		}
         else
         {
-			surface.AddQuadCD(cell.i, !cell.a.IsFilled());
+			surface.AddQuadCD(cell.i, !cell.a->IsFilled());
 		}
 	}
 
@@ -267,11 +288,11 @@ public:
     {
 		if (f.exists)
         {
-			surface.AddPentagonADToB(cell.i, f.position, !cell.b.IsFilled());
+			surface.AddPentagonADToB(cell.i, f.position, !cell.b->IsFilled());
 		}
         else
         {
-			surface.AddQuadADToB(cell.i, !cell.b.IsFilled());
+			surface.AddQuadADToB(cell.i, !cell.b->IsFilled());
 		}
 	}
 	
@@ -279,11 +300,11 @@ public:
     {
 		if (f.exists)
         {
-			surface.AddPentagonADToC(cell.i, f.position, !cell.c.IsFilled());
+			surface.AddPentagonADToC(cell.i, f.position, !cell.c->IsFilled());
 		}
         else
         {
-			surface.AddQuadADToC(cell.i, !cell.c.IsFilled());
+			surface.AddQuadADToC(cell.i, !cell.c->IsFilled());
 		}
 	}
 	
@@ -291,11 +312,11 @@ public:
     {
 		if (f.exists)
         {
-			surface.AddPentagonBCToA(cell.i, f.position, !cell.a.IsFilled());
+			surface.AddPentagonBCToA(cell.i, f.position, !cell.a->IsFilled());
 		}
         else
         {
-			surface.AddQuadBCToA(cell.i, !cell.a.IsFilled());
+			surface.AddQuadBCToA(cell.i, !cell.a->IsFilled());
 		}
 	}
 	
@@ -303,11 +324,11 @@ public:
     {
 		if (f.exists)
         {
-			surface.AddPentagonBCToD(cell.i, f.position, !cell.d.IsFilled());
+			surface.AddPentagonBCToD(cell.i, f.position, !cell.d->IsFilled());
 		}
         else
         {
-			surface.AddQuadBCToD(cell.i, !cell.d.IsFilled());
+			surface.AddQuadBCToD(cell.i, !cell.d->IsFilled());
 		}
 	}
 
@@ -315,4 +336,9 @@ public:
     {
 		surface.AddQuadABCD(cell.i);
 	}
+
+	void FillUniform(int32 xCells, int32 yCells, float cellSize)
+    {
+		surface.AddUniformFill(xCells, yCells, cellSize);
+	}
 };
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Reference counted copy-on-write storage.
+//
+// Copies share the stored value, the value is cloned on the first
+// mutable access of a copy while the value is still shared.
+
+template<typename ValueType>
+class TPMUVoxelSharedData
+{
+    typedef TSharedRef<ValueType, ESPMode::ThreadSafe> FValueRef;
+
+    FValueRef Value;
+
+public:
+
+    TPMUVoxelSharedData()
+        : Value(MakeShareable(new ValueType))
+    {
+    }
+
+    FORCEINLINE const ValueType& Get() const
+    {
+        return Value.Get();
+    }
+
+    FORCEINLINE const ValueType& operator*() const
+    {
+        return Value.Get();
+    }
+
+    FORCEINLINE const ValueType* operator->() const
+    {
+        return &Value.Get();
+    }
+
+    FORCEINLINE bool IsShared() const
+    {
+        return ! Value.IsUnique();
+    }
+
+    // Mutable access, clones shared value
+
+    ValueType& Edit()
+    {
+        if (! Value.IsUnique())
+        {
+            Value = MakeShareable(new ValueType(Value.Get()));
+        }
+
+        return Value.Get();
+    }
+
+    // Mutable access for callers that have already detached the value
+
+    FORCEINLINE ValueType& GetMutable()
+    {
+        checkSlow(Value.IsUnique());
+        return Value.Get();
+    }
+
+    // Replace value with a new default constructed value
+
+    void Renew()
+    {
+        Value = MakeShareable(new ValueType);
+    }
+};
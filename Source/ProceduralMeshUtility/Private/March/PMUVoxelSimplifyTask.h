@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/AsyncWork.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Mesh/PMUMeshTypes.h"
+#include "Mesh/Simplify/PMUMeshSimplifier.h"
+
+// Deferred simplification job, shared between a chunk and its background
+// task. The chunk cancels the job when it is edited or re-triangulated,
+// cancelled jobs are skipped by the task or discarded on completion.
+
+struct FPMUVoxelSimplifyJob
+{
+    int32 StateIndex = 0;
+    FPMUMeshSection Section;
+    FPMUMeshSimplifierOptions Options;
+
+    FThreadSafeBool bCancelled = false;
+    FThreadSafeBool bCompleted = false;
+};
+
+typedef TSharedPtr<FPMUVoxelSimplifyJob, ESPMode::ThreadSafe> FPSPMUVoxelSimplifyJob;
+
+class FPMUVoxelSimplifyTask : public FNonAbandonableTask
+{
+    friend class FAutoDeleteAsyncTask<FPMUVoxelSimplifyTask>;
+
+    FPSPMUVoxelSimplifyJob Job;
+
+    FPMUVoxelSimplifyTask(const FPSPMUVoxelSimplifyJob& InJob)
+        : Job(InJob)
+    {
+    }
+
+    void DoWork()
+    {
+        if (Job->bCancelled)
+        {
+            return;
+        }
+
+        FPMUMeshSimplifier& Simplifier(FPMUMeshSimplifier::GetThreadSimplifier());
+        Simplifier.Simplify(
+            Job->Section,
+            FVector::ZeroVector,
+            Job->Options
+            );
+        Simplifier.TrimWorkspace();
+
+        Job->bCompleted = true;
+    }
+
+    FORCEINLINE TStatId GetStatId() const
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(FPMUVoxelSimplifyTask, STATGROUP_ThreadPoolAsyncTasks);
+    }
+};
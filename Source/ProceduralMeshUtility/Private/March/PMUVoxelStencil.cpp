@@ -26,9 +26,24 @@
 // 
 
 #include "March/PMUVoxelStencil.h"
+#include "Async/ParallelFor.h"
+#include "ProceduralMeshUtility.h"
 #include "PMUVoxelGrid.h"
 #include "PMUVoxel.h"
 
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelStencil ~ Edit Map Batched"), STAT_PMUVoxelStencil_EditMapBatched, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelStencil ~ Edit Map Batched Bin"), STAT_PMUVoxelStencil_EditMapBatchedBin, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelStencil ~ Edit Map Batched States"), STAT_PMUVoxelStencil_EditMapBatchedStates, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUVoxelStencil ~ Edit Map Batched Crossings"), STAT_PMUVoxelStencil_EditMapBatchedCrossings, STATGROUP_ProceduralMeshUtility);
+
+// Signed distance edits also write distances of voxels surrounding
+// the stencil, up to the voxel distance range
+
+static FORCEINLINE int32 GetMapPadding(const FPMUVoxelMap& Map)
+{
+    return Map.bSignedDistance ? FPMUVoxelData::DistanceRange : 1;
+}
+
 void FPMUVoxelStencil::ValidateHorizontalNormal(FPMUVoxel& xMin, const FPMUVoxel& xMax)
 {
     if (xMin.state < xMax.state)
@@ -92,7 +107,7 @@ void FPMUVoxelStencil::EditMap(FPMUVoxelMap& Map, const FVector2D& center)
 
     Initialize(Map);
     SetCenter(center.X, center.Y);
-    GetMapRange(xStart, xEnd, yStart, yEnd, voxelSize, chunkSize, chunkResolution);
+    GetMapRange(xStart, xEnd, yStart, yEnd, voxelSize, chunkSize, chunkResolution, GetMapPadding(Map));
 
     for (int32 y=yEnd; y>=yStart; y--)
     {
@@ -103,10 +118,18 @@ void FPMUVoxelStencil::EditMap(FPMUVoxelMap& Map, const FVector2D& center)
             const float centerX = center.X - x * chunkSize;
             const float centerY = center.Y - y * chunkSize;
             SetCenter(centerX, centerY);
-            SetVoxels(*Map.chunks[i]);
+            SetVoxels(Map.AcquireChunk(i));
+            Map.MarkChunkDirty(x, y);
         }
     }
 
+    // Signed distance chunks derive crossings on triangulation
+
+    if (Map.bSignedDistance)
+    {
+        return;
+    }
+
     for (int32 y=yEnd; y>=yStart; y--)
     {
         int32 i = y * chunkResolution + xEnd;
@@ -115,10 +138,11 @@ void FPMUVoxelStencil::EditMap(FPMUVoxelMap& Map, const FVector2D& center)
         {
             const float centerX = center.X - x * chunkSize;
             const float centerY = center.Y - y * chunkSize;
-            FPMUVoxelGrid& Chunk(*Map.chunks[i]);
+            FPMUVoxelGrid& Chunk(Map.AcquireChunk(i));
 
             SetCenter(centerX, centerY);
             SetCrossings(Chunk);
+            Map.MarkChunkDirty(x, y);
         }
     }
 }
@@ -132,7 +156,7 @@ void FPMUVoxelStencil::EditStates(FPMUVoxelMap& Map, const FVector2D& center)
 
     Initialize(Map);
     SetCenter(center.X, center.Y);
-    GetMapRange(xStart, xEnd, yStart, yEnd, voxelSize, chunkSize, chunkResolution);
+    GetMapRange(xStart, xEnd, yStart, yEnd, voxelSize, chunkSize, chunkResolution, GetMapPadding(Map));
 
     for (int32 y=yEnd; y>=yStart; y--)
     {
@@ -143,7 +167,8 @@ void FPMUVoxelStencil::EditStates(FPMUVoxelMap& Map, const FVector2D& center)
             const float centerX = center.X - x * chunkSize;
             const float centerY = center.Y - y * chunkSize;
             SetCenter(centerX, centerY);
-            SetVoxels(*Map.chunks[i]);
+            SetVoxels(Map.AcquireChunk(i));
+            Map.MarkChunkDirty(x, y);
         }
     }
 }
@@ -157,7 +182,7 @@ void FPMUVoxelStencil::EditCrossings(FPMUVoxelMap& Map, const FVector2D& center)
 
     Initialize(Map);
     SetCenter(center.X, center.Y);
-    GetMapRange(xStart, xEnd, yStart, yEnd, voxelSize, chunkSize, chunkResolution);
+    GetMapRange(xStart, xEnd, yStart, yEnd, voxelSize, chunkSize, chunkResolution, GetMapPadding(Map));
 
     for (int32 y=yEnd; y>=yStart; y--)
     {
@@ -169,11 +194,108 @@ void FPMUVoxelStencil::EditCrossings(FPMUVoxelMap& Map, const FVector2D& center)
             const float centerY = center.Y - y * chunkSize;
 
             SetCenter(centerX, centerY);
-            SetCrossings(*Map.chunks[i]);
+            SetCrossings(Map.AcquireChunk(i));
+            Map.MarkChunkDirty(x, y);
         }
     }
 }
 
+void FPMUVoxelStencil::EditMapBatched(FPMUVoxelMap& Map, const TArray<FPMUVoxelStencilInstance>& Stencils)
+{
+    SCOPE_CYCLE_COUNTER(STAT_PMUVoxelStencil_EditMapBatched);
+
+    const float voxelSize = Map.voxelSize;
+    const float chunkSize = Map.chunkSize;
+    const int32 chunkResolution = Map.chunkResolution;
+    const int32 chunkCount = Map.chunks.Num();
+
+    // Bin stencils by overlapping chunks, bins keep stencil order
+
+    TArray<TArray<int32>> ChunkStencils;
+    TArray<int32> ChunkIndices;
+
+    ChunkStencils.SetNum(chunkCount);
+
+    {
+        SCOPE_CYCLE_COUNTER(STAT_PMUVoxelStencil_EditMapBatchedBin);
+
+        for (int32 si=0; si<Stencils.Num(); ++si)
+        {
+            const FPMUVoxelStencilInstance& Instance(Stencils[si]);
+            FPMUVoxelStencil& Stencil(*Instance.Stencil);
+            int32 xStart, xEnd, yStart, yEnd;
+
+            Stencil.Initialize(Map);
+            Stencil.SetCenter(Instance.Center.X, Instance.Center.Y);
+            Stencil.GetMapRange(xStart, xEnd, yStart, yEnd, voxelSize, chunkSize, chunkResolution, GetMapPadding(Map));
+
+            for (int32 y=yStart; y<=yEnd; ++y)
+            for (int32 x=xStart; x<=xEnd; ++x)
+            {
+                TArray<int32>& Bin(ChunkStencils[y * chunkResolution + x]);
+
+                // Streamed chunks are acquired here, before chunk tasks run
+
+                if (Bin.Num() == 0)
+                {
+                    Map.AcquireChunk(y * chunkResolution + x);
+                    ChunkIndices.Emplace(y * chunkResolution + x);
+                }
+
+                Bin.Emplace(si);
+            }
+        }
+    }
+
+    // Apply stencils on each chunk. Every stencil is cloned per chunk
+    // since positioning a stencil on a chunk mutates the stencil center.
+    //
+    // Crossings read neighbour chunk states so all states have to be
+    // written before any chunk evaluates its crossings. Signed distance
+    // chunks only read their own voxels and are done in a single pass.
+
+    auto ApplyChunkStencils = [&](int32 ci, bool bCrossings)
+    {
+        const int32 i = ChunkIndices[ci];
+        const int32 x = i % chunkResolution;
+        const int32 y = i / chunkResolution;
+        FPMUVoxelGrid& Chunk(*Map.chunks[i]);
+
+        for (int32 si : ChunkStencils[i])
+        {
+            const FPMUVoxelStencilInstance& Instance(Stencils[si]);
+            TSharedRef<FPMUVoxelStencil> Stencil(Instance.Stencil->Clone());
+
+            Stencil->SetCenter(
+                Instance.Center.X - x * chunkSize,
+                Instance.Center.Y - y * chunkSize
+                );
+
+            if (bCrossings)
+            {
+                Stencil->SetCrossings(Chunk);
+            }
+            else
+            {
+                Stencil->SetVoxels(Chunk);
+            }
+        }
+
+        Map.MarkChunkDirty(x, y);
+    };
+
+    {
+        SCOPE_CYCLE_COUNTER(STAT_PMUVoxelStencil_EditMapBatchedStates);
+        ParallelFor(ChunkIndices.Num(), [&](int32 ci) { ApplyChunkStencils(ci, false); });
+    }
+
+    if (! Map.bSignedDistance)
+    {
+        SCOPE_CYCLE_COUNTER(STAT_PMUVoxelStencil_EditMapBatchedCrossings);
+        ParallelFor(ChunkIndices.Num(), [&](int32 ci) { ApplyChunkStencils(ci, true); });
+    }
+}
+
 void FPMUVoxelStencil::GetChunkIndices(FPMUVoxelMap& Map, const FVector2D& center, TArray<int32>& OutIndices)
 {
     const float voxelSize = Map.voxelSize;
@@ -183,7 +305,7 @@ void FPMUVoxelStencil::GetChunkIndices(FPMUVoxelMap& Map, const FVector2D& cente
 
     Initialize(Map);
     SetCenter(center.X, center.Y);
-    GetMapRange(xStart, xEnd, yStart, yEnd, voxelSize, chunkSize, chunkResolution);
+    GetMapRange(xStart, xEnd, yStart, yEnd, voxelSize, chunkSize, chunkResolution, GetMapPadding(Map));
 
     OutIndices.Reset(chunkResolution * chunkResolution);
 
@@ -203,12 +325,26 @@ void FPMUVoxelStencil::GetChunkIndices(FPMUVoxelMap& Map, const FVector2D& cente
 void FPMUVoxelStencil::SetVoxels(FPMUVoxelGrid& Chunk)
 {
     int32 xStart, xEnd, yStart, yEnd;
+
+    if (Chunk.HasDistances())
+    {
+        GetChunkRange(xStart, xEnd, yStart, yEnd, Chunk.voxelSize, Chunk.voxelResolution, FPMUVoxelData::DistanceRange);
+        Chunk.SetDistances(*this, xStart, xEnd, yStart, yEnd);
+        return;
+    }
+
     GetChunkRange(xStart, xEnd, yStart, yEnd, Chunk.voxelSize, Chunk.voxelResolution);
     ApplyVoxels(Chunk, xStart, xEnd, yStart, yEnd);
 }
 
 void FPMUVoxelStencil::SetCrossings(FPMUVoxelGrid& Chunk)
 {
+    // Signed distance chunks have no stored crossings
+    if (Chunk.HasDistances())
+    {
+        return;
+    }
+
     int32 xStart, xEnd, yStart, yEnd;
     GetChunkRange(xStart, xEnd, yStart, yEnd, Chunk.voxelSize, Chunk.voxelResolution);
     ApplyCrossings(Chunk, xStart, xEnd, yStart, yEnd);
@@ -224,6 +360,20 @@ void FPMUVoxelStencil::ApplyVoxel(FPMUVoxel& voxel) const
     }
 }
 
+float FPMUVoxelStencil::GetDistance(const FVector2D& position) const
+{
+    const FVector2D extents((GetXEnd() - GetXStart()) * .5f, (GetYEnd() - GetYStart()) * .5f);
+    const FVector2D offset(
+        FMath::Abs(position.X - (GetXStart() + extents.X)) - extents.X,
+        FMath::Abs(position.Y - (GetYStart() + extents.Y)) - extents.Y
+        );
+
+    const float outside = FVector2D(FMath::Max(offset.X, 0.f), FMath::Max(offset.Y, 0.f)).Size();
+    const float inside = FMath::Min(FMath::Max(offset.X, offset.Y), 0.f);
+
+    return outside + inside;
+}
+
 void FPMUVoxelStencil::ApplyVoxels(FPMUVoxelGrid& Chunk, const int32 x0, const int32 x1, const int32 y0, const int32 y1)
 {
     Chunk.SetStates(*this, x0, x1, y0, y1);
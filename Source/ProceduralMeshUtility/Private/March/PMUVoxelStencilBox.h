@@ -193,10 +193,15 @@ public:
             SetBounds(BoundsSetting);
         }
     }
+
+    virtual TSharedRef<FPMUVoxelStencil> Clone() const override
+    {
+        return MakeShareable(new FPMUVoxelStencilBox(*this));
+    }
 };
 
 UCLASS(BlueprintType)
-class UPMUVoxelStencilBoxRef : public UObject
+class UPMUVoxelStencilBoxRef : public UPMUVoxelStencilRef
 {
     GENERATED_BODY()
 
@@ -210,6 +215,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0"))
     int32 FillType = 0;
 
+    // Stencil center used by batched map edits
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FVector2D Origin = FVector2D::ZeroVector;
+
     UFUNCTION(BlueprintCallable)
     void EditMap(UPMUVoxelMapRef* MapRef, FVector2D Center)
     {
@@ -220,6 +229,13 @@ public:
             Stencil.EditMap(MapRef->GetMap(), Center);
         }
     }
+
+    virtual void GetStencilInstances(TArray<FPMUVoxelStencilInstance>& OutStencils) override
+    {
+        Stencil.BoundsSetting = Bounds;
+        Stencil.FillTypeSetting = FillType;
+        OutStencils.Emplace(&Stencil, Origin);
+    }
 };
 
 UCLASS(BlueprintType)
@@ -236,21 +252,18 @@ public:
 
     void EditMap(FPMUVoxelMap& Map, const FVector2D& Center)
     {
-        // Edit map states
-        for (FPMUVoxelStencilBox& Stencil : Stencils)
-        {
-            FVector2D BoxCenter = Center + Stencil.GetCenter();
-            Stencil.EditStates(Map, BoxCenter);
-        }
+        TArray<FPMUVoxelStencilInstance> Instances;
+        Instances.Reserve(Stencils.Num());
 
-        // Edit map voxel crossings
         for (FPMUVoxelStencilBox& Stencil : Stencils)
         {
-            FVector2D BoxCenter = Center + Stencil.GetCenter();
-            Stencil.EditCrossings(Map, BoxCenter);
+            Instances.Emplace(&Stencil, Center + Stencil.GetCenter());
         }
 
-        Map.RefreshAllChunks();
+        FPMUVoxelStencil::EditMapBatched(Map, Instances);
+
+        TArray<int32> ChunkIndices;
+        Map.RefreshDirtyChunks(ChunkIndices);
     }
 
     UFUNCTION(BlueprintCallable)
@@ -151,10 +151,20 @@ public:
 			voxel.state = fillType;
 		}
 	}
+
+    virtual float GetDistance(const FVector2D& position) const override
+    {
+        return FVector2D(position.X - centerX, position.Y - centerY).Size() - radius;
+    }
+
+    virtual TSharedRef<FPMUVoxelStencil> Clone() const override
+    {
+        return MakeShareable(new FPMUVoxelStencilCircle(*this));
+    }
 };
 
 UCLASS(BlueprintType)
-class UPMUVoxelStencilCircleRef : public UObject
+class UPMUVoxelStencilCircleRef : public UPMUVoxelStencilRef
 {
     GENERATED_BODY()
 
@@ -168,6 +178,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0"))
     int32 FillType = 0;
 
+    // Stencil center used by batched map edits
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FVector2D Origin = FVector2D::ZeroVector;
+
     UFUNCTION(BlueprintCallable)
     void EditMap(UPMUVoxelMapRef* MapRef, FVector2D Center)
     {
@@ -179,8 +193,19 @@ public:
         }
     }
 
-    UFUNCTION(BlueprintCallable)
-    TArray<int32> GetChunkIndices(UPMUVoxelMapRef* MapRef, FVector2D Center)
+    virtual void GetStencilInstances(TArray<FPMUVoxelStencilInstance>& OutStencils) override
+    {
+        Stencil.RadiusSetting = Radius;
+        Stencil.FillTypeSetting = FillType;
+        OutStencils.Emplace(&Stencil, Origin);
+    }
+
+    virtual TArray<int32> GetChunkIndices(UPMUVoxelMapRef* MapRef) override
+    {
+        return GetChunkIndicesAt(MapRef, Origin);
+    }
+
+    virtual TArray<int32> GetChunkIndicesAt(UPMUVoxelMapRef* MapRef, FVector2D Center) override
     {
         TArray<int32> ChunkIndices;
 
@@ -141,6 +141,17 @@ public:
         }
     }
 
+    virtual void GetStencilInstances(TArray<FPMUVoxelStencilInstance>& OutStencils) override
+    {
+        OutStencils.Reserve(OutStencils.Num() + Stencils.Num());
+
+        for (FPMUVoxelStencilTri& Stencil : Stencils)
+        {
+            Stencil.FillTypeSetting = FillType;
+            OutStencils.Emplace(&Stencil, Stencil.GetShiftedBoundsCenter());
+        }
+    }
+
     FORCEINLINE virtual void EditMapAsync(FPSGWTAsyncTask& Task, FPMUVoxelMap& Map) override
     {
         Task->AddTask([this, &Map](){ EditMap(Map); });
@@ -148,10 +148,15 @@ public:
         //radius = (RadiusSetting + 0.5f) * VoxelMap.GetVoxelSize();
         radius = (RadiusSetting + 0.5f);
     }
+
+    virtual TSharedRef<FPMUVoxelStencil> Clone() const override
+    {
+        return MakeShareable(new FPMUVoxelStencilSquare(*this));
+    }
 };
 
 UCLASS(BlueprintType)
-class UPMUVoxelStencilSquareRef : public UObject
+class UPMUVoxelStencilSquareRef : public UPMUVoxelStencilRef
 {
     GENERATED_BODY()
 
@@ -165,6 +170,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0"))
     int32 FillType = 0;
 
+    // Stencil center used by batched map edits
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FVector2D Origin = FVector2D::ZeroVector;
+
     UFUNCTION(BlueprintCallable)
     void EditMap(UPMUVoxelMapRef* MapRef, FVector2D Center)
     {
@@ -175,4 +184,11 @@ public:
             Stencil.EditMap(MapRef->GetMap(), Center);
         }
     }
+
+    virtual void GetStencilInstances(TArray<FPMUVoxelStencilInstance>& OutStencils) override
+    {
+        Stencil.RadiusSetting = Radius;
+        Stencil.FillTypeSetting = FillType;
+        OutStencils.Emplace(&Stencil, Origin);
+    }
 };
@@ -230,6 +230,23 @@ public:
         }
     }
 
+    virtual float GetDistance(const FVector2D& position) const override
+    {
+        const FVector2D P0(Pos[0]);
+        const FVector2D P1(Pos[1]);
+        const FVector2D P2(Pos[2]);
+
+        const float DistSq = FMath::Min3(
+            FVector2D::DistSquared(position, FMath::ClosestPointOnSegment2D(position, P0, P1)),
+            FVector2D::DistSquared(position, FMath::ClosestPointOnSegment2D(position, P1, P2)),
+            FVector2D::DistSquared(position, FMath::ClosestPointOnSegment2D(position, P2, P0))
+            );
+
+        const float Dist = FMath::Sqrt(DistSq);
+
+        return UPMUUtilityLibrary::IsPointOnTri(FVector(position, 0.f), Pos[0], Pos[1], Pos[2]) ? -Dist : Dist;
+    }
+
     void SetPositions(const FVector& Pos0, const FVector& Pos1, const FVector& Pos2)
     {
         // Calculate tri bounds
@@ -258,10 +275,15 @@ public:
         Nrm[1].Set(-Nrm12.Y, Nrm12.X);
         Nrm[2].Set(-Nrm20.Y, Nrm20.X);
     }
+
+    virtual TSharedRef<FPMUVoxelStencil> Clone() const override
+    {
+        return MakeShareable(new FPMUVoxelStencilTri(*this));
+    }
 };
 
 UCLASS(BlueprintType)
-class UPMUVoxelStencilTriRef : public UObject
+class UPMUVoxelStencilTriRef : public UPMUVoxelStencilRef
 {
     GENERATED_BODY()
 
@@ -320,6 +342,13 @@ public:
         }
     }
 
+    // Batched edits place the triangle at its positions, as poly stencils do
+    virtual void GetStencilInstances(TArray<FPMUVoxelStencilInstance>& OutStencils) override
+    {
+        Stencil.FillTypeSetting = FillType;
+        OutStencils.Emplace(&Stencil, Stencil.GetShiftedBoundsCenter());
+    }
+
     UFUNCTION(BlueprintCallable)
     void SetPositions(FVector Pos0, FVector Pos1, FVector Pos2, bool bInverse = false)
     {
@@ -26,6 +26,9 @@
 // 
 
 #include "PMUVoxelSurface.h"
+#include "ProceduralMeshUtility.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("PMUVoxelSurface ~ Buffer Allocations"), STAT_PMUVoxelSurface_BufferAllocations, STATGROUP_ProceduralMeshUtility);
 
 #ifdef PMU_VOXEL_USE_OCL
 
@@ -78,6 +81,8 @@ void FPMUVoxelSurface::Initialize(const FPMUVoxelSurfaceConfig& Config)
 
     bGenerateExtrusion = Config.bGenerateExtrusion;
     bExtrusionSurface  = (! bGenerateExtrusion && Config.bExtrusionSurface);
+    bMergeInteriorCells = Config.bMergeInteriorCells;
+    bDeferSimplification = Config.bDeferSimplification;
     extrusionHeight = (FMath::Abs(Config.ExtrusionHeight) > 0.01f) ? -FMath::Abs(Config.ExtrusionHeight) : -1.f;
 
     // Grid data height map configuration
@@ -184,6 +189,8 @@ void FPMUVoxelSurface::Initialize(const FPMUVoxelSurfaceConfig& Config)
         }
     }
 
+    BuildGradientLookup();
+
 #ifdef PMU_VOXEL_USE_OCL
     // GPU program configuration
 
@@ -203,18 +210,13 @@ void FPMUVoxelSurface::Initialize(const FPMUVoxelSurfaceConfig& Config)
 
 #endif
 
-    // Resize vertex cache containers
-    
-    cornersMin.SetNum(voxelResolution + 1);
-    cornersMax.SetNum(voxelResolution + 1);
+    // Row caches and geometry containers are allocated once the surface
+    // state first occurs in chunk triangulation, see InitializeRowCaches()
 
-    xEdgesMin.SetNum(voxelResolution);
-    xEdgesMax.SetNum(voxelResolution);
-
-    // Reserves geometry container spaces
-
-    Section.VertexBuffer.Reserve(voxelCount);
-    Section.IndexBuffer.Reserve(voxelCount * 6);
+    cornersMin.Empty();
+    cornersMax.Empty();
+    xEdgesMin.Empty();
+    xEdgesMax.Empty();
 }
 
 void FPMUVoxelSurface::CopyFrom(const FPMUVoxelSurface& Surface)
@@ -237,6 +239,9 @@ void FPMUVoxelSurface::CopyFrom(const FPMUVoxelSurface& Surface)
     bExtrusionSurface  = Surface.bExtrusionSurface;
     extrusionHeight    = Surface.extrusionHeight;
 
+    bMergeInteriorCells = Surface.bMergeInteriorCells;
+    bDeferSimplification = Surface.bDeferSimplification;
+
     // Grid data height map configuration
 
     GridData           = Surface.GridData;
@@ -270,12 +275,34 @@ void FPMUVoxelSurface::CopyFrom(const FPMUVoxelSurface& Surface)
         }
     }
 
+    GradientFeatureOrigin = Surface.GradientFeatureOrigin;
+    GradientFeatureDim    = Surface.GradientFeatureDim;
+    GradientFeatures      = Surface.GradientFeatures;
+    GradientRasterDim     = Surface.GradientRasterDim;
+    GradientRasters       = Surface.GradientRasters;
+
 #ifdef PMU_VOXEL_USE_OCL
     // GPU program configuration
     GPUProgram     = Surface.GPUProgram;
     bUseGPUProgram = Surface.bUseGPUProgram;
 #endif
 
+    // Row caches and geometry containers are allocated once the surface
+    // state first occurs in chunk triangulation, see InitializeRowCaches()
+
+    cornersMin.Empty();
+    cornersMax.Empty();
+    xEdgesMin.Empty();
+    xEdgesMax.Empty();
+}
+
+void FPMUVoxelSurface::InitializeRowCaches()
+{
+    if (cornersMin.Num() == (voxelResolution + 1))
+    {
+        return;
+    }
+
     // Resize vertex cache containers
     
     cornersMin.SetNum(voxelResolution + 1);
@@ -290,64 +317,356 @@ void FPMUVoxelSurface::CopyFrom(const FPMUVoxelSurface& Surface)
     Section.IndexBuffer.Reserve(voxelCount * 6);
 }
 
+void FPMUVoxelSurface::AppendBand(const FPMUVoxelSurface& Band)
+{
+    // Band geometry starts with its seam row vertices which duplicate the
+    // current last row vertices. Seam vertices are mapped through the row
+    // caches of both surfaces, the rest are offset past current vertices.
+    // Resulting geometry matches serial triangulation of the band rows.
+
+    const int32 seamCount = Band.bandSeamVertexCount;
+    const int32 bandVertexCount = Band.GetVertexCount();
+    const int32 vertexOffset = GetVertexCount() - seamCount;
+    const int32 vertexStride = bGenerateExtrusion ? 2 : 1;
+
+    TArray<int32>& remap(bandVertexRemap);
+    remap.Init(INDEX_NONE, seamCount);
+
+    auto MapSeam = [&](const TArray<int32>& seamCache, const TArray<int32>& rowCache)
+    {
+        for (int32 i=0; i<seamCache.Num(); ++i)
+        {
+            const int32 seamIndex = seamCache[i];
+
+            if (seamIndex != INDEX_NONE)
+            {
+                for (int32 k=0; k<vertexStride; ++k)
+                {
+                    remap[seamIndex + k] = rowCache[i] + k;
+                }
+            }
+        }
+    };
+
+    MapSeam(Band.bandSeamCorners, cornersMax);
+    MapSeam(Band.bandSeamXEdges, xEdgesMax);
+
+    auto Remap = [&](int32 Index)
+    {
+        return (Index < seamCount) ? remap[Index] : (Index + vertexOffset);
+    };
+
+    // Append geometry
+
+    const FPMUMeshSection& BandSection(Band.Section);
+
+    Section.VertexBuffer.Append(
+        BandSection.VertexBuffer.GetData() + seamCount,
+        bandVertexCount - seamCount
+        );
+
+    Section.IndexBuffer.Reserve(Section.IndexBuffer.Num() + BandSection.IndexBuffer.Num());
+
+    for (int32 Index : BandSection.IndexBuffer)
+    {
+        Section.IndexBuffer.Emplace(Remap(Index));
+    }
+
+    EdgeStream.Reserve(EdgeStream.Num() + Band.EdgeStream.Num());
+
+    for (int32 Index : Band.EdgeStream)
+    {
+        EdgeStream.Emplace(Remap(Index));
+    }
+
+    Section.LocalBox += BandSection.LocalBox;
+
+    // Continue row caches from the band last row, entries of corners and
+    // edges that were not generated on the last row are never read
+
+    auto ContinueCache = [&](TArray<int32>& rowCache, const TArray<int32>& bandCache)
+    {
+        for (int32 i=0; i<rowCache.Num(); ++i)
+        {
+            const int32 Index = bandCache[i];
+            rowCache[i] = (Index >= 0 && Index < bandVertexCount) ? Remap(Index) : INDEX_NONE;
+        }
+    };
+
+    ContinueCache(cornersMax, Band.cornersMax);
+    ContinueCache(xEdgesMax, Band.xEdgesMax);
+}
+
+void FPMUVoxelSurface::AddUniformFill(int32 xCells, int32 yCells, float cellSize)
+{
+    auto GetCorner = [&](int32 x, int32 y)
+    {
+        return FVector2D(x*cellSize + voxelSizeHalf, y*cellSize + voxelSizeHalf);
+    };
+
+    // Merging surface collapses the whole fill into a single rectangle
+
+    if (bMergeInteriorCells)
+    {
+        const int32 a = AddVertex2(GetCorner(0, 0));
+        const int32 b = AddVertex2(GetCorner(xCells, 0));
+        const int32 c = AddVertex2(GetCorner(0, yCells));
+        const int32 d = AddVertex2(GetCorner(xCells, yCells));
+
+        AddQuad(a, c, d, b);
+        return;
+    }
+
+    // Emit cell corner lattice followed by per-cell quads with the same
+    // winding as AddQuadABCD()
+
+    const int32 baseIndex = GetVertexCount();
+    const int32 vertexStride = bGenerateExtrusion ? 2 : 1;
+    const int32 rowStride = (xCells + 1) * vertexStride;
+
+    for (int32 y=0; y<=yCells; ++y)
+    for (int32 x=0; x<=xCells; ++x)
+    {
+        AddVertex2(GetCorner(x, y));
+    }
+
+    for (int32 y=0; y<yCells; ++y)
+    for (int32 x=0; x<xCells; ++x)
+    {
+        const int32 a = baseIndex + y*rowStride + x*vertexStride;
+        const int32 b = a + vertexStride;
+        const int32 c = a + rowStride;
+        const int32 d = c + vertexStride;
+
+        AddQuad(a, c, d, b);
+    }
+}
+
+void FPMUVoxelSurface::BuildGradientLookup()
+{
+    GradientFeatureOrigin = FIntPoint::ZeroValue;
+    GradientFeatureDim    = FIntPoint::ZeroValue;
+    GradientFeatures.Empty();
+    GradientRasterDim = 0;
+    GradientRasters.Empty();
+
+    if (! bHasGradientData)
+    {
+        return;
+    }
+
+    check(GradientMap != nullptr);
+
+    // Bake gradient map features of map cells overlapping the chunk,
+    // vertices may extend up to a voxel past chunk dimension on gap cells
+
+    const FIntPoint FeatureMin(
+        FMath::Clamp(FMath::FloorToInt(position.X), 0, mapSize-1),
+        FMath::Clamp(FMath::FloorToInt(position.Y), 0, mapSize-1)
+        );
+    const FIntPoint FeatureMax(
+        FMath::Clamp(FMath::CeilToInt(position.X+gridSize+voxelSize), 0, mapSize-1),
+        FMath::Clamp(FMath::CeilToInt(position.Y+gridSize+voxelSize), 0, mapSize-1)
+        );
+
+    GradientFeatureOrigin = FeatureMin;
+    GradientFeatureDim    = FeatureMax - FeatureMin + FIntPoint(1, 1);
+    GradientFeatures.SetNumUninitialized(GradientFeatureDim.X * GradientFeatureDim.Y);
+
+    for (int32 y=0, i=0; y<GradientFeatureDim.Y; ++y)
+    for (int32 x=0; x<GradientFeatureDim.X; ++x, ++i)
+    {
+        const int32 Index = (FeatureMin.X+x) + (FeatureMin.Y+y)*mapSize;
+        const uint8* Value = GradientMap->GetValue(Index);
+        GradientFeatures[i] = Value ? *Value : 0;
+    }
+
+    // Bake clamped distance ratio of each geometry group at voxel corners
+
+    const int32 Dim = voxelResolution + 2;
+
+    GradientRasterDim = Dim;
+    GradientRasters.SetNumUninitialized(GradientPartitions.Num() * Dim * Dim);
+
+    for (int32 g=0, i=0; g<GradientPartitions.Num(); ++g)
+    for (int32 y=0; y<Dim; ++y)
+    for (int32 x=0; x<Dim; ++x, ++i)
+    {
+        const FVector2D Point(position.X + x*voxelSize, position.Y + y*voxelSize);
+        GradientRasters[i] = GetGeometryGroupAlpha(g, Point);
+    }
+}
+
+void FPMUVoxelSurface::ShrinkBuffers()
+{
+    Section.Shrink();
+    EdgeStream.Shrink();
+    EdgeVertexFlags.Shrink();
+
+    bufferAllocatedSize = GetBufferAllocatedSize();
+}
+
+void FPMUVoxelSurface::UpdateBufferAllocationCount()
+{
+    // Any change in allocated size means at least one geometry
+    // container had to reallocate during the last rebuild
+
+    if (GetBufferAllocatedSize() != bufferAllocatedSize)
+    {
+        ++bufferAllocationCount;
+        INC_DWORD_STAT(STAT_PMUVoxelSurface_BufferAllocations);
+    }
+}
+
 void FPMUVoxelSurface::GenerateEdgeNormals()
 {
-    if (bGenerateExtrusion)
+    if (! bGenerateExtrusion)
+    {
+        return;
+    }
+
+    const int32 VertexCount = Section.VertexBuffer.Num();
+    const int32 EdgeCount = EdgeStream.Num() / 2;
+    const int32* Edges = EdgeStream.GetData();
+    FPMUMeshVertex* Vertices = Section.VertexBuffer.GetData();
+
+    // Mark edge vertices
+
+    EdgeVertexFlags.Reset();
+    EdgeVertexFlags.SetNumZeroed(VertexCount);
+
+    uint8* Flags = EdgeVertexFlags.GetData();
+
+    for (int32 i=0; i<EdgeStream.Num(); ++i)
+    {
+        Flags[Edges[i]] = 1;
+    }
+
+    // Accumulate edge normals, four edges at a time.
+    //
+    // Edge normal is the safe normalized edge direction crossed with
+    // the up vector, which reduces to (dy, -dx, 0) scaled by the inverse
+    // edge length.
+
+    const VectorRegister Tolerance = VectorSetFloat1(SMALL_NUMBER);
+
+    MS_ALIGN(16) float DX[4] GCC_ALIGN(16);
+    MS_ALIGN(16) float DY[4] GCC_ALIGN(16);
+    MS_ALIGN(16) float DZ[4] GCC_ALIGN(16);
+
+    int32 ei = 0;
+
+    for (; (ei+4)<=EdgeCount; ei+=4)
     {
-        for (const TPair<int32, int32>& EdgePair : EdgePairs)
+        for (int32 l=0; l<4; ++l)
         {
-            const int32& a(EdgePair.Key);
-            const int32& b(EdgePair.Value);
+            const int32* Edge = Edges + (ei+l)*2;
+            const FVector EdgeDelta = Vertices[Edge[0]].Position - Vertices[Edge[1]].Position;
+            DX[l] = EdgeDelta.X;
+            DY[l] = EdgeDelta.Y;
+            DZ[l] = EdgeDelta.Z;
+        }
+
+        const VectorRegister X = VectorLoadAligned(DX);
+        const VectorRegister Y = VectorLoadAligned(DY);
+        const VectorRegister Z = VectorLoadAligned(DZ);
+
+        VectorRegister SizeSq = VectorMultiply(X, X);
+        SizeSq = VectorMultiplyAdd(Y, Y, SizeSq);
+        SizeSq = VectorMultiplyAdd(Z, Z, SizeSq);
+
+        const VectorRegister Scale = VectorSelect(
+            VectorCompareGT(SizeSq, Tolerance),
+            VectorReciprocalSqrtAccurate(SizeSq),
+            VectorZero()
+            );
+
+        VectorStoreAligned(VectorMultiply(Y, Scale), DX);
+        VectorStoreAligned(VectorNegate(VectorMultiply(X, Scale)), DY);
 
-            const FVector& v0(Section.VertexBuffer[a].Position);
-            const FVector& v1(Section.VertexBuffer[b].Position);
+        for (int32 l=0; l<4; ++l)
+        {
+            const int32* Edge = Edges + (ei+l)*2;
+            const int32 a = Edge[0];
+            const int32 b = Edge[1];
+            const FVector EdgeCross(DX[l], DY[l], 0.f);
+
+            Vertices[a  ].Normal += EdgeCross;
+            Vertices[b  ].Normal += EdgeCross;
+            Vertices[a+1].Normal += EdgeCross;
+            Vertices[b+1].Normal += EdgeCross;
+        }
+    }
+
+    for (; ei<EdgeCount; ++ei)
+    {
+        const int32 a = Edges[ei*2  ];
+        const int32 b = Edges[ei*2+1];
+
+        const FVector& v0(Vertices[a].Position);
+        const FVector& v1(Vertices[b].Position);
+
+        const FVector EdgeDirection = (v0-v1).GetSafeNormal();
+        const FVector EdgeCross = EdgeDirection ^ FVector::UpVector;
+
+        Vertices[a  ].Normal += EdgeCross;
+        Vertices[b  ].Normal += EdgeCross;
+        Vertices[a+1].Normal += EdgeCross;
+        Vertices[b+1].Normal += EdgeCross;
+    }
 
-            const FVector EdgeDirection = (v0-v1).GetSafeNormal();
-            const FVector EdgeCross = EdgeDirection ^ FVector::UpVector;
+    // Normalize edge vertex normals
 
-            Section.VertexBuffer[a  ].Normal += EdgeCross;
-            Section.VertexBuffer[b  ].Normal += EdgeCross;
-            Section.VertexBuffer[a+1].Normal += EdgeCross;
-            Section.VertexBuffer[b+1].Normal += EdgeCross;
+    for (int32 i=0; i<VertexCount; ++i)
+    {
+        if (! Flags[i])
+        {
+            continue;
         }
 
-        for (int32 i : EdgeIndexSet)
+        for (int32 vi=i; vi<(i+2); ++vi)
         {
-            Section.VertexBuffer[i  ].Normal.Normalize();
-            Section.VertexBuffer[i+1].Normal.Normalize();
+            FVector& Normal(Vertices[vi].Normal);
+
+            const VectorRegister N = VectorLoadFloat3_W0(&Normal);
+            const VectorRegister SizeSq = VectorDot3(N, N);
+            const VectorRegister Result = VectorSelect(
+                VectorCompareGT(SizeSq, Tolerance),
+                VectorMultiply(N, VectorReciprocalSqrtAccurate(SizeSq)),
+                N
+                );
+
+            VectorStoreFloat3(Result, &Normal);
         }
     }
 }
 
 void FPMUVoxelSurface::ApplyVertex()
 {
-    if (bGenerateExtrusion && SimplifierOptions.bEnabled)
+    // Deferred simplification publishes the raw triangulation with
+    // vertex height, gradient and edge normals applied, simplifier
+    // keeps those attributes on the simplified vertices
+
+    const bool bSimplify = SimplifierOptions.bEnabled && ! bDeferSimplification;
+
+    if (bGenerateExtrusion && bSimplify)
     {
         // Generate vertex height normal
         if (bHasHeightMap)
         {
-            for (FPMUMeshVertex& Vertex : Section.VertexBuffer)
-            {
-                FVector& Position(Vertex.Position);
-                const float PX = Position.X + voxelSizeHalf;
-                const float PY = Position.Y + voxelSizeHalf;
-
-                // Map height
-                GetVertexHeight(PX, PY, (Vertex.Normal.Z < 0.f), Vertex.Normal, Position.Z);
-
-                Section.LocalBox += Position;
-            }
+            ApplyVertexHeight();
         }
 
         GenerateEdgeNormals();
 
         // Simplify mesh
-        FPMUMeshSimplifier Simplifier;
+        FPMUMeshSimplifier& Simplifier(FPMUMeshSimplifier::GetThreadSimplifier());
         Simplifier.Simplify(
             Section,
             FVector::ZeroVector,
             SimplifierOptions
             );
+        Simplifier.TrimWorkspace();
 
         // Generate vertex color gradient
         if (bHasGradientData)
@@ -365,7 +684,14 @@ void FPMUVoxelSurface::ApplyVertex()
     }
     else
     {
-        if (bHasHeightMap || bHasGradientData)
+        // Map height
+        if (bHasHeightMap)
+        {
+            ApplyVertexHeight();
+        }
+
+        // Map color gradient
+        if (bHasGradientData)
         {
             for (FPMUMeshVertex& Vertex : Section.VertexBuffer)
             {
@@ -373,31 +699,20 @@ void FPMUVoxelSurface::ApplyVertex()
                 const float PX = Position.X + voxelSizeHalf;
                 const float PY = Position.Y + voxelSizeHalf;
 
-                // Map height
-                if (bHasHeightMap)
-                {
-                    GetVertexHeight(PX, PY, (Vertex.Normal.Z < 0.f), Vertex.Normal, Position.Z);
-                }
-
-                // Map color gradient
-                if (bHasGradientData)
-                {
-                    GetVertexGradient(PX, PY, Vertex.Color);
-                }
-
-                Section.LocalBox += Position;
+                GetVertexGradient(PX, PY, Vertex.Color);
             }
         }
 
         // Simplify mesh if required
-        if (SimplifierOptions.bEnabled)
+        if (bSimplify)
         {
-            FPMUMeshSimplifier Simplifier;
+            FPMUMeshSimplifier& Simplifier(FPMUMeshSimplifier::GetThreadSimplifier());
             Simplifier.Simplify(
                 Section,
                 FVector::ZeroVector,
                 SimplifierOptions
                 );
+            Simplifier.TrimWorkspace();
         }
         else if (bGenerateExtrusion)
         {
@@ -406,6 +721,250 @@ void FPMUVoxelSurface::ApplyVertex()
     }
 }
 
+void FPMUVoxelSurface::ApplyVertexHeight_Scalar()
+{
+    for (FPMUMeshVertex& Vertex : Section.VertexBuffer)
+    {
+        FVector& Position(Vertex.Position);
+        const float PX = Position.X + voxelSizeHalf;
+        const float PY = Position.Y + voxelSizeHalf;
+
+        GetVertexHeight(PX, PY, (Vertex.Normal.Z < 0.f), Vertex.Normal, Position.Z);
+
+        Section.LocalBox += Position;
+    }
+}
+
+void FPMUVoxelSurface::ApplyVertexHeight()
+{
+    check(GridData != nullptr);
+    check(GridRangeMin.X > 0.f);
+    check(GridRangeMin.Y > 0.f);
+    check(GridRangeMax.X > GridRangeMin.X);
+    check(GridRangeMax.Y > GridRangeMin.Y);
+
+#ifdef PMU_VOXEL_CHECK_HEIGHT_SAMPLING
+    TArray<FPMUMeshVertex> ReferenceVertices(Section.VertexBuffer);
+#endif
+
+    // Resolve surface and extrusion height maps once for the whole buffer
+
+    const float* SurfaceMap = nullptr;
+    const float* ExtrudeMap = nullptr;
+
+    switch (HeightMapType & 3)
+    {
+        case 1:
+            SurfaceMap = GridData->GetHeightMapChecked(ShapeHeightMapId).GetData();
+            break;
+
+        case 2:
+        case 3:
+            SurfaceMap = GridData->GetHeightMapChecked(SurfaceHeightMapId).GetData();
+            break;
+    }
+
+    switch (HeightMapType & 5)
+    {
+        case 1:
+            ExtrudeMap = GridData->GetHeightMapChecked(ShapeHeightMapId).GetData();
+            break;
+
+        case 4:
+        case 5:
+            ExtrudeMap = GridData->GetHeightMapChecked(ExtrudeHeightMapId).GetData();
+            break;
+    }
+
+    const FIntPoint& Dim(GridData->Dimension);
+    const int32 Stride = Dim.X;
+    const int32 VertexCount = Section.VertexBuffer.Num();
+    FPMUMeshVertex* Vertices = Section.VertexBuffer.GetData();
+
+    // Height map texels surrounding each sample, laid out per lane.
+    //
+    // Sample point (IX, IY) with its west, north, east and south neighbours
+    // covers a 4x4 texel block without its corners:
+    //
+    //       N0 N1
+    //    W0 C0 C1 E0
+    //    W1 C2 C3 E1
+    //       S0 S1
+
+    enum { N0, N1, W0, C0, C1, E0, W1, C2, C3, E1, S0, S1, TEXEL_COUNT };
+
+    MS_ALIGN(16) float Texels[TEXEL_COUNT][4] GCC_ALIGN(16);
+    MS_ALIGN(16) float FX[4] GCC_ALIGN(16);
+    MS_ALIGN(16) float FY[4] GCC_ALIGN(16);
+    MS_ALIGN(16) float OutH[4] GCC_ALIGN(16);
+    MS_ALIGN(16) float OutNX[4] GCC_ALIGN(16);
+    MS_ALIGN(16) float OutNY[4] GCC_ALIGN(16);
+    MS_ALIGN(16) float OutNZ[4] GCC_ALIGN(16);
+    bool bSampled[4];
+
+    for (int32 vi=0; vi<VertexCount; vi+=4)
+    {
+        const int32 LaneCount = FMath::Min(4, VertexCount-vi);
+
+        // Gather texels
+
+        for (int32 l=0; l<4; ++l)
+        {
+            const float* HeightMap = nullptr;
+
+            if (l < LaneCount)
+            {
+                const FPMUMeshVertex& Vertex(Vertices[vi+l]);
+                HeightMap = (Vertex.Normal.Z < 0.f) ? ExtrudeMap : SurfaceMap;
+            }
+
+            bSampled[l] = (HeightMap != nullptr);
+
+            if (! bSampled[l])
+            {
+                FX[l] = 0.f;
+                FY[l] = 0.f;
+
+                for (int32 t=0; t<TEXEL_COUNT; ++t)
+                {
+                    Texels[t][l] = 0.f;
+                }
+
+                continue;
+            }
+
+            const FVector& Position(Vertices[vi+l].Position);
+            const float GridX = FMath::Clamp(Position.X + voxelSizeHalf, GridRangeMin.X, GridRangeMax.X);
+            const float GridY = FMath::Clamp(Position.Y + voxelSizeHalf, GridRangeMin.Y, GridRangeMax.Y);
+            const int32 IX = GridX;
+            const int32 IY = GridY;
+
+            // Grid range clamp keeps (IX-1, IY-1) and (IX+1, IY+1) in bounds.
+            // The far column and row only exist with zero interpolation weight
+            // on the last safe texel, clamp them to the map border.
+            const int32 X0 = IX-1;
+            const int32 X1 = IX;
+            const int32 X2 = IX+1;
+            const int32 X3 = FMath::Min(IX+2, Dim.X-1);
+            const int32 R0 = (IY-1) * Stride;
+            const int32 R1 =  IY    * Stride;
+            const int32 R2 = (IY+1) * Stride;
+            const int32 R3 = FMath::Min(IY+2, Dim.Y-1) * Stride;
+
+            FX[l] = FMath::Clamp(GridX-IX, 0.f, 1.f);
+            FY[l] = FMath::Clamp(GridY-IY, 0.f, 1.f);
+
+            Texels[N0][l] = HeightMap[R0+X1];
+            Texels[N1][l] = HeightMap[R0+X2];
+            Texels[W0][l] = HeightMap[R1+X0];
+            Texels[C0][l] = HeightMap[R1+X1];
+            Texels[C1][l] = HeightMap[R1+X2];
+            Texels[E0][l] = HeightMap[R1+X3];
+            Texels[W1][l] = HeightMap[R2+X0];
+            Texels[C2][l] = HeightMap[R2+X1];
+            Texels[C3][l] = HeightMap[R2+X2];
+            Texels[E1][l] = HeightMap[R2+X3];
+            Texels[S0][l] = HeightMap[R3+X1];
+            Texels[S1][l] = HeightMap[R3+X2];
+        }
+
+        // Interpolate center and neighbour heights
+
+        const VectorRegister VFX = VectorLoadAligned(FX);
+        const VectorRegister VFY = VectorLoadAligned(FY);
+
+        auto Lerp = [](const VectorRegister& A, const VectorRegister& B, const VectorRegister& Alpha)
+        {
+            return VectorMultiplyAdd(Alpha, VectorSubtract(B, A), A);
+        };
+
+        auto BiLerp = [&](int32 T00, int32 T10, int32 T01, int32 T11)
+        {
+            return Lerp(
+                Lerp(VectorLoadAligned(Texels[T00]), VectorLoadAligned(Texels[T10]), VFX),
+                Lerp(VectorLoadAligned(Texels[T01]), VectorLoadAligned(Texels[T11]), VFX),
+                VFY
+                );
+        };
+
+        const VectorRegister HV = BiLerp(C0, C1, C2, C3);
+        const VectorRegister HW = BiLerp(W0, C0, W1, C2);
+        const VectorRegister HE = BiLerp(C1, E0, C3, E1);
+        const VectorRegister HN = BiLerp(N0, N1, C0, C1);
+        const VectorRegister HS = BiLerp(C2, C3, S0, S1);
+
+        // Normal (-(hE-hW), -(hS-hN), 1) normalized, the Z component keeps
+        // the squared size above normalization tolerance
+
+        const VectorRegister NX = VectorSubtract(HW, HE);
+        const VectorRegister NY = VectorSubtract(HN, HS);
+
+        VectorRegister SizeSq = VectorMultiplyAdd(NX, NX, VectorOne());
+        SizeSq = VectorMultiplyAdd(NY, NY, SizeSq);
+
+        const VectorRegister InvSize = VectorReciprocalSqrtAccurate(SizeSq);
+
+        VectorStoreAligned(HV, OutH);
+        VectorStoreAligned(VectorMultiply(NX, InvSize), OutNX);
+        VectorStoreAligned(VectorMultiply(NY, InvSize), OutNY);
+        VectorStoreAligned(InvSize, OutNZ);
+
+        // Scatter results
+
+        for (int32 l=0; l<LaneCount; ++l)
+        {
+            FPMUMeshVertex& Vertex(Vertices[vi+l]);
+            FVector& Position(Vertex.Position);
+            const bool bIsExtrusion = (Vertex.Normal.Z < 0.f);
+
+            if (bSampled[l])
+            {
+                Position.Z = OutH[l];
+                Vertex.Normal.Set(OutNX[l], OutNY[l], OutNZ[l]);
+            }
+
+            if (bIsExtrusion)
+            {
+                Position.Z += extrusionHeight;
+                Vertex.Normal = -Vertex.Normal;
+            }
+
+            Section.LocalBox += Position;
+        }
+    }
+
+#ifdef PMU_VOXEL_CHECK_HEIGHT_SAMPLING
+    // Compare against scalar reference implementation
+    {
+        TArray<FPMUMeshVertex> BatchVertices(MoveTemp(Section.VertexBuffer));
+        FBox BatchBox(Section.LocalBox);
+
+        Section.VertexBuffer = MoveTemp(ReferenceVertices);
+        ApplyVertexHeight_Scalar();
+
+        for (int32 i=0; i<VertexCount; ++i)
+        {
+            const FPMUMeshVertex& V0(Section.VertexBuffer[i]);
+            const FPMUMeshVertex& V1(BatchVertices[i]);
+
+            ensureMsgf(
+                FMath::IsNearlyEqual(V0.Position.Z, V1.Position.Z, KINDA_SMALL_NUMBER) &&
+                V0.Normal.Equals(V1.Normal, KINDA_SMALL_NUMBER),
+                TEXT("FPMUVoxelSurface::ApplyVertexHeight() batched sampling mismatch at vertex %d (%s, %s) != reference (%s, %s)"),
+                i,
+                *V1.Position.ToString(),
+                *V1.Normal.ToString(),
+                *V0.Position.ToString(),
+                *V0.Normal.ToString()
+                );
+        }
+
+        Section.VertexBuffer = MoveTemp(BatchVertices);
+        Section.LocalBox = BatchBox;
+    }
+#endif
+}
+
 #ifdef PMU_VOXEL_USE_OCL
 
 void FPMUVoxelSurface::ApplyVertex_GPU()
@@ -622,14 +1181,15 @@ bool FPMUVoxelSurface::ApplyVertex_GPU_Impl()
         }
 
         // Simplify mesh if required
-        if (SimplifierOptions.bEnabled)
+        if (SimplifierOptions.bEnabled && ! bDeferSimplification)
         {
-            FPMUMeshSimplifier Simplifier;
+            FPMUMeshSimplifier& Simplifier(FPMUMeshSimplifier::GetThreadSimplifier());
             Simplifier.Simplify(
                 Section,
                 FVector::ZeroVector,
                 SimplifierOptions
                 );
+            Simplifier.TrimWorkspace();
         }
 
         // Expand local bounds and generate gradient data
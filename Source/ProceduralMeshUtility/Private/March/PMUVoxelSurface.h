@@ -57,6 +57,12 @@ private:
     bool bExtrusionSurface;
 	float extrusionHeight;
 
+    bool bMergeInteriorCells = false;
+
+    // Simplification is left to a background job scheduled by the
+    // chunk, raw triangulation is published in the meantime
+    bool bDeferSimplification = false;
+
 	int32 voxelResolution;
     int32 voxelCount;
     FVector2D position;
@@ -74,12 +80,28 @@ private:
 	int32 yEdgeMin;
 	int32 yEdgeMax;
 
-    TSet<int32> EdgeIndexSet;
-    TArray<TPair<int32, int32>> EdgePairs;
+    // Extrusion edge vertex pairs stored contiguously as (a, b) index pairs,
+    // edge vertex flags are indexed by vertex and built on edge normal generation
+
+    TArray<int32> EdgeStream;
+    TArray<uint8> EdgeVertexFlags;
+
+    // Row band seam caches, see AppendBand()
+
+    int32 bandSeamVertexCount = 0;
+    TArray<int32> bandSeamCorners;
+    TArray<int32> bandSeamXEdges;
+    TArray<int32> bandVertexRemap;
 
     FPMUMeshSimplifierOptions SimplifierOptions;
     FPMUMeshSection Section;
 
+    // Geometry buffers keep their capacity across rebuilds,
+    // allocation count records rebuilds that had to reallocate them
+
+    SIZE_T bufferAllocatedSize = 0;
+    int32 bufferAllocationCount = 0;
+
     // Height map grid data
 
     FPMUGridData* GridData = nullptr;
@@ -100,6 +122,16 @@ private:
     uint8 GradientType = 0;
     float GradientExponent = 1.f;
 
+    // Baked chunk-local gradient lookup. Feature grid holds gradient map
+    // values of map cells overlapping the chunk, distance ratio rasters hold
+    // per geometry group clamped distance ratio sampled at voxel corners.
+
+    FIntPoint GradientFeatureOrigin;
+    FIntPoint GradientFeatureDim;
+    TArray<uint8> GradientFeatures;
+    int32 GradientRasterDim = 0;
+    TArray<float> GradientRasters;
+
 #ifdef PMU_VOXEL_USE_OCL
     // GPU program data
     bool bUseGPUProgram = false;
@@ -111,12 +143,20 @@ public:
 
     void Initialize(const FPMUVoxelSurfaceConfig& Config);
     void CopyFrom(const FPMUVoxelSurface& Surface);
+    void InitializeRowCaches();
+
+    FORCEINLINE bool IsSimplificationDeferred() const
+    {
+        return bDeferSimplification && SimplifierOptions.bEnabled;
+    }
 
 	void Clear()
     {
-        Section.ClearGeometry();
-        EdgeIndexSet.Empty();
-        EdgePairs.Empty();
+        Section.ResetGeometry();
+        EdgeStream.Reset();
+        EdgeVertexFlags.Reset();
+
+        bufferAllocatedSize = GetBufferAllocatedSize();
 	}
 
 	void Apply()
@@ -127,28 +167,47 @@ public:
         ApplyVertex();
 #endif
 
-        // Compact geometry containers
-        Section.Shrink();
+        UpdateBufferAllocationCount();
 	}
 
+    void ShrinkBuffers();
+
+    FORCEINLINE SIZE_T GetBufferAllocatedSize() const
+    {
+        return Section.VertexBuffer.GetAllocatedSize()
+            + Section.IndexBuffer.GetAllocatedSize()
+            + EdgeStream.GetAllocatedSize()
+            + EdgeVertexFlags.GetAllocatedSize();
+    }
+
+    FORCEINLINE int32 GetBufferAllocationCount() const
+    {
+        return bufferAllocationCount;
+    }
+
     FORCEINLINE int32 GetVertexCount() const
     {
         return Section.GetVertexCount();
     }
 
-	FORCEINLINE void CacheFirstCorner(const FPMUVoxel& voxel)
+    FORCEINLINE bool IsMergingInteriorCells() const
+    {
+        return bMergeInteriorCells;
+    }
+
+	FORCEINLINE int32 CacheFirstCorner(const FVector2D& corner)
     {
-		cornersMax[0] = AddVertex2(voxel.position);
+		return cornersMax[0] = AddVertex2(corner);
 	}
 
-	FORCEINLINE void CacheNextCorner(int32 i, const FPMUVoxel& voxel)
+	FORCEINLINE int32 CacheNextCorner(int32 i, const FVector2D& corner)
     {
-		cornersMax[i + 1] = AddVertex2(voxel.position);
+		return cornersMax[i + 1] = AddVertex2(corner);
 	}
 
-	FORCEINLINE void CacheXEdge(int32 i, const FPMUVoxel& voxel)
+	FORCEINLINE void CacheXEdge(int32 i, const FVector2D& edgePoint)
     {
-        FVector2D EdgePoint(voxel.GetXEdgePoint());
+        FVector2D EdgePoint(edgePoint);
 
         if (EdgePoint.X < 0.f)
         {
@@ -158,10 +217,9 @@ public:
 		xEdgesMax[i] = AddVertex4(EdgePoint);
 	}
 
-	FORCEINLINE void CacheYEdge(const FPMUVoxel& voxel)
+	FORCEINLINE void CacheYEdge(const FVector2D& edgePoint)
     {
-        FVector2D EdgePoint(voxel.GetYEdgePoint());
-		yEdgeMax = AddVertex4(EdgePoint);
+		yEdgeMax = AddVertex4(edgePoint);
 	}
 
 	FORCEINLINE void PrepareCacheForNextCell()
@@ -182,6 +240,51 @@ public:
     {
 		AddQuad(cornersMin[i], cornersMax[i], cornersMax[i + 1], cornersMin[i + 1]);
 	}
+
+    // Row band triangulation
+
+    void BeginBandSeam()
+    {
+        for (int32& Index : cornersMax) Index = INDEX_NONE;
+        for (int32& Index : xEdgesMax) Index = INDEX_NONE;
+    }
+
+    void EndBandSeam()
+    {
+        bandSeamCorners = cornersMax;
+        bandSeamXEdges  = xEdgesMax;
+        bandSeamVertexCount = GetVertexCount();
+    }
+
+    void AppendBand(const FPMUVoxelSurface& Band);
+
+    // Closed-form fill of a uniformly filled chunk, see AddUniformFill().
+    // Cell size differs from voxel size on downsampled LOD grids.
+    void AddUniformFill(int32 xCells, int32 yCells, float cellSize);
+
+    // Merged cell rectangle, perimeter vertices are ordered the same as
+    // AddQuadABCD() corners. Rectangles with vertices along their edges
+    // are fanned around a center vertex to avoid degenerate triangles.
+
+    void AddMergedQuad(const TArray<int32>& perimeter, const FVector2D& center)
+    {
+        const int32 count = perimeter.Num();
+
+        check(count >= 4);
+
+        if (count == 4)
+        {
+            AddQuad(perimeter[0], perimeter[1], perimeter[2], perimeter[3]);
+            return;
+        }
+
+        const int32 centerIndex = AddVertex2(center);
+
+        for (int32 i=0, j=count-1; i<count; j=i++)
+        {
+            AddTriangle(centerIndex, perimeter[j], perimeter[i]);
+        }
+    }
 	
 	FORCEINLINE void AddTriangleA(int32 i, const bool bWall0)
     {
@@ -609,9 +712,8 @@ private:
         IndexBuffer.Emplace(eb1);
         IndexBuffer.Emplace(ea0);
 
-        EdgeIndexSet.Emplace(a);
-        EdgeIndexSet.Emplace(b);
-        EdgePairs.Emplace(a, b);
+        EdgeStream.Emplace(a);
+        EdgeStream.Emplace(b);
 
         //const FVector& v0(Section.VertexBuffer[a].Position);
         //const FVector& v1(Section.VertexBuffer[b].Position);
@@ -738,16 +840,73 @@ private:
         }
     }
 
+    FORCEINLINE uint8 GetGradientFeature(const float PX, const float PY) const
+    {
+        check(GradientMap != nullptr);
+
+        const int32 IX = FMath::Clamp(static_cast<int32>(PX), 0, mapSize-1);
+        const int32 IY = FMath::Clamp(static_cast<int32>(PY), 0, mapSize-1);
+        const int32 LX = IX - GradientFeatureOrigin.X;
+        const int32 LY = IY - GradientFeatureOrigin.Y;
+
+        if (LX >= 0 && LX < GradientFeatureDim.X && LY >= 0 && LY < GradientFeatureDim.Y)
+        {
+            return GradientFeatures[LX + LY*GradientFeatureDim.X];
+        }
+
+        // Outside of baked chunk features, fallback to gradient map lookup
+        const int32 Index = IX+IY*mapSize;
+        return GradientMap->HasValue(Index) ? GradientMap->GetValueChecked(Index) : 0;
+    }
+
+    float GetGeometryGroupAlpha(int32 GeometryGroupId, const FVector2D& Point) const
+    {
+        check(GradientPartitions.IsValidIndex(GeometryGroupId));
+
+        const FPMUDFGeometryPartition& GeometryPartitionRoot(GradientPartitions[GeometryGroupId]);
+        float GradientAlpha = 1.f;
+
+        if (const FPMUDFGeometryPartition* GeometryPartition = GeometryPartitionRoot.GetPartition(Point))
+        {
+            for (const FPMUDFGeometry* Geom : GeometryPartition->GetGeometry())
+            {
+                if (Geom->IsWithinBoundingRadius(Point))
+                {
+                    GradientAlpha = FMath::Min(GradientAlpha, Geom->GetClampedDistanceRatio(Point));
+                }
+            }
+        }
+
+        return GradientAlpha;
+    }
+
+    FORCEINLINE float SampleGradientRaster(int32 GeometryGroupId, const float PX, const float PY) const
+    {
+        const int32 Dim = GradientRasterDim;
+        const float* Raster = GradientRasters.GetData() + GeometryGroupId*Dim*Dim;
+
+        check(GradientRasters.Num() >= (GeometryGroupId+1)*Dim*Dim);
+
+        const float U = FMath::Clamp((PX-position.X) * voxelSizeInv, 0.f, Dim-1.f);
+        const float V = FMath::Clamp((PY-position.Y) * voxelSizeInv, 0.f, Dim-1.f);
+        const int32 IX = FMath::Min(static_cast<int32>(U), Dim-2);
+        const int32 IY = FMath::Min(static_cast<int32>(V), Dim-2);
+        const int32 i = IX + IY*Dim;
+
+        return FMath::BiLerp(
+            Raster[i    ], Raster[i+1    ],
+            Raster[i+Dim], Raster[i+Dim+1],
+            U-IX,
+            V-IY
+            );
+    }
+
     void GetVertexGradient(const float PX, const float PY, FColor& Color) const
     {
         check(bHasGradientData);
         check(GradientMap != nullptr);
 
-        const FVector2D OffsetPoint(PX, PY);
-        const int32 IX = FMath::Clamp(static_cast<int32>(OffsetPoint.X), 0, mapSize-1);
-        const int32 IY = FMath::Clamp(static_cast<int32>(OffsetPoint.Y), 0, mapSize-1);
-        const int32 Index = IX+IY*mapSize;
-        uint8 FeatureType = GradientMap->HasValue(Index) ? GradientMap->GetValueChecked(Index) : 0;
+        const uint8 FeatureType = GetGradientFeature(PX, PY);
 
         check(FPMUGradientUtility::IsValidValue(FeatureType));
 
@@ -757,24 +916,10 @@ private:
             {
                 check(GradientPartitions.Num() == 1);
 
-                float GradientAlpha = 1.f;
+                float GradientAlpha = SampleGradientRaster(0, PX, PY);
                 float BaseValue = (FeatureType == 0) ? 0.f : 1.f;
                 float Ratio;
 
-                const FVector2D Point(PX, PY);
-                const FPMUDFGeometryPartition& GeometryPartitionRoot(GradientPartitions[0]);
-
-                if (const FPMUDFGeometryPartition* GeometryPartition = GeometryPartitionRoot.GetPartition(Point))
-                {
-                    for (const FPMUDFGeometry* Geom : GeometryPartition->GetGeometry())
-                    {
-                        if (Geom->IsWithinBoundingRadius(Point))
-                        {
-                            GradientAlpha = FMath::Min(GradientAlpha, Geom->GetClampedDistanceRatio(Point));
-                        }
-                    }
-                }
-
                 Ratio = FMath::InterpEaseOut(0.5f, BaseValue, GradientAlpha, GradientExponent);
                 Color = FLinearColor(Ratio, 0.f, 0.f).ToFColor(false);
             }
@@ -822,44 +967,29 @@ private:
 
         if (FeatureType != JunctionType1)
         {
-            const int32 GeometryGroupId = JunctionType0;
-            const FPMUDFGeometryPartition& GeometryPartitionRoot(GradientPartitions[GeometryGroupId]);
-
-            if (const FPMUDFGeometryPartition* GeometryPartition = GeometryPartitionRoot.GetPartition(Point))
-            {
-                for (const FPMUDFGeometry* Geom : GeometryPartition->GetGeometry())
-                {
-                    if (Geom->IsWithinBoundingRadius(Point))
-                    {
-                        GradientAlpha = FMath::Min(GradientAlpha, Geom->GetClampedDistanceRatio(Point));
-                    }
-                }
-            }
+            GradientAlpha = FMath::Min(GradientAlpha, SampleGradientRaster(JunctionType0, Point.X, Point.Y));
         }
 
         if (FeatureType != JunctionType2)
         {
-            const int32 GeometryGroupId = JunctionType1;
-            const FPMUDFGeometryPartition& GeometryPartitionRoot(GradientPartitions[GeometryGroupId]);
-
-            if (const FPMUDFGeometryPartition* GeometryPartition = GeometryPartitionRoot.GetPartition(Point))
-            {
-                for (const FPMUDFGeometry* Geom : GeometryPartition->GetGeometry())
-                {
-                    if (Geom->IsWithinBoundingRadius(Point))
-                    {
-                        GradientAlpha = FMath::Min(GradientAlpha, Geom->GetClampedDistanceRatio(Point));
-                    }
-                }
-            }
+            GradientAlpha = FMath::Min(GradientAlpha, SampleGradientRaster(JunctionType1, Point.X, Point.Y));
         }
 
         return 1.f - FMath::InterpEaseOut(0.5f, BaseValue, GradientAlpha, GradientExponent);
     }
 
+    void BuildGradientLookup();
     void GenerateEdgeNormals();
     void ApplyVertex();
 
+    // Batched vertex height sampling, processes four vertices at a time
+    void ApplyVertexHeight();
+
+    // Per-vertex reference implementation of ApplyVertexHeight()
+    void ApplyVertexHeight_Scalar();
+
+    void UpdateBufferAllocationCount();
+
 #ifdef PMU_VOXEL_USE_OCL
     void ApplyVertex_GPU();
     bool ApplyVertex_GPU_Impl();
@@ -682,6 +682,12 @@ void UPMUMeshComponent::CreateMeshSection(
     FPMUMeshSection& NewSection = MeshSections[SectionIndex];
     NewSection.Reset();
 
+    // Collapse sequence of the previous geometry is no longer valid
+    if (SectionCollapseSequences.IsValidIndex(SectionIndex))
+    {
+        SectionCollapseSequences[SectionIndex].Empty();
+    }
+
     // Copy data to vertex buffer
     const int32 NumVerts = Vertices.Num();
     NewSection.VertexBuffer.Reset();
@@ -760,6 +766,12 @@ void UPMUMeshComponent::UpdateMeshSection(
         FPMUMeshSection& Section = MeshSections[SectionIndex];
         const int32 NumVerts = Section.VertexBuffer.Num();
 
+        // Collapse sequence records the previous vertex data
+        if (SectionCollapseSequences.IsValidIndex(SectionIndex))
+        {
+            SectionCollapseSequences[SectionIndex].Empty();
+        }
+
         // See if positions are changing
         const bool bPositionsChanging = (Vertices.Num() == NumVerts);
 
@@ -884,6 +896,12 @@ void UPMUMeshComponent::ClearMeshSectionGeometry(int32 SectionIndex)
     if (MeshSections.IsValidIndex(SectionIndex))
     {
         MeshSections[SectionIndex].Reset();
+
+        if (SectionCollapseSequences.IsValidIndex(SectionIndex))
+        {
+            SectionCollapseSequences[SectionIndex].Empty();
+        }
+
         UpdateLocalBounds();
         UpdateCollision();
         MarkRenderStateDirty();
@@ -893,6 +911,7 @@ void UPMUMeshComponent::ClearMeshSectionGeometry(int32 SectionIndex)
 void UPMUMeshComponent::ClearAllMeshSections()
 {
     MeshSections.Empty();
+    SectionCollapseSequences.Empty();
     UpdateLocalBounds();
     UpdateCollision();
     MarkRenderStateDirty();
@@ -1016,6 +1035,12 @@ void UPMUMeshComponent::SetNumMeshSections(int32 SectionCount, bool bAllowShrink
     {
         MeshSections.SetNum(SectionCount, bAllowShrinking);
     }
+
+    // Collapse sequences are only kept for existing sections
+    if (SectionCollapseSequences.Num() > MeshSections.Num())
+    {
+        SectionCollapseSequences.SetNum(MeshSections.Num(), bAllowShrinking);
+    }
 }
 
 void UPMUMeshComponent::SetNumSectionResources(int32 SectionCount, bool bAllowShrinking)
@@ -1041,6 +1066,11 @@ void UPMUMeshComponent::SetMeshSection(int32 SectionIndex, const FPMUMeshSection
 
     MeshSections[SectionIndex] = Section;
 
+    if (SectionCollapseSequences.IsValidIndex(SectionIndex))
+    {
+        SectionCollapseSequences[SectionIndex].Empty();
+    }
+
     if (bUpdateRenderState)
     {
         UpdateLocalBounds();
@@ -1103,8 +1133,48 @@ void UPMUMeshComponent::SimplifySection(int32 SectionIndex, const FPMUMeshSimpli
 {
     if (MeshSections.IsValidIndex(SectionIndex))
     {
-        FPMUMeshSimplifier Simplifier;
+        FPMUMeshSimplifier& Simplifier(FPMUMeshSimplifier::GetThreadSimplifier());
         Simplifier.Simplify(MeshSections[SectionIndex], FVector::ZeroVector, Options);
+        Simplifier.TrimWorkspace();
+    }
+}
+
+void UPMUMeshComponent::BuildSectionCollapseSequence(int32 SectionIndex, const FPMUMeshSimplifierOptions& Options)
+{
+    if (MeshSections.IsValidIndex(SectionIndex))
+    {
+        if (SectionIndex >= SectionCollapseSequences.Num())
+        {
+            SectionCollapseSequences.SetNum(SectionIndex + 1, false);
+        }
+
+        FPMUMeshSimplifier& Simplifier(FPMUMeshSimplifier::GetThreadSimplifier());
+        Simplifier.BuildCollapseSequence(MeshSections[SectionIndex], Options, SectionCollapseSequences[SectionIndex]);
+        Simplifier.TrimWorkspace();
+    }
+}
+
+bool UPMUMeshComponent::HasSectionCollapseSequence(int32 SectionIndex) const
+{
+    return SectionCollapseSequences.IsValidIndex(SectionIndex)
+        ? SectionCollapseSequences[SectionIndex].IsValid()
+        : false;
+}
+
+void UPMUMeshComponent::SetSectionTriangleCount(int32 SectionIndex, int32 TargetTriangleCount, bool bUpdateRenderState)
+{
+    if (! MeshSections.IsValidIndex(SectionIndex) || ! HasSectionCollapseSequence(SectionIndex))
+    {
+        return;
+    }
+
+    SectionCollapseSequences[SectionIndex].GenerateSection(TargetTriangleCount, MeshSections[SectionIndex]);
+
+    if (bUpdateRenderState)
+    {
+        UpdateLocalBounds();
+        UpdateCollision();
+        MarkRenderStateDirty();
     }
 }
 
@@ -218,6 +218,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Components|ProceduralMesh")
 	void SimplifySection(int32 SectionIndex, const FPMUMeshSimplifierOptions& Options);
 
+	/** Record the section collapse sequence from current section geometry for progressive LOD */
+	UFUNCTION(BlueprintCallable, Category="Components|ProceduralMesh")
+	void BuildSectionCollapseSequence(int32 SectionIndex, const FPMUMeshSimplifierOptions& Options);
+
+	/** Returns whether a section has a recorded collapse sequence */
+	UFUNCTION(BlueprintCallable, Category="Components|ProceduralMesh")
+	bool HasSectionCollapseSequence(int32 SectionIndex) const;
+
+	/** Regenerate section geometry from its collapse sequence at the target triangle count */
+	UFUNCTION(BlueprintCallable, Category="Components|ProceduralMesh")
+	void SetSectionTriangleCount(int32 SectionIndex, int32 TargetTriangleCount, bool bUpdateRenderState = true);
+
 	//~ Begin UObject Interface
 	virtual void PostLoad() override;
 	//~ End UObject Interface.
@@ -258,6 +270,10 @@ private:
 	UPROPERTY()
 	TArray<FPMUMeshSection> MeshSections;
 
+	/** Progressive LOD collapse sequences of mesh sections */
+	UPROPERTY()
+	TArray<FPMUMeshCollapseSequence> SectionCollapseSequences;
+
 	/** Array of sections of mesh (section resource) */
 	UPROPERTY()
 	TArray<FPMUMeshSectionResource> SectionResources;
@@ -27,18 +27,336 @@
 
 #include "Mesh/Simplify/PMUMeshSimplifier.h"
 #include "Mesh/PMUMeshTypes.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformAtomics.h"
+#include "ProceduralMeshUtility.h"
 
 #define QEF_INCLUDE_IMPL
 #include "qef_simd.h"
 
 #include <random>
 
+DECLARE_CYCLE_STAT(TEXT("PMUMeshSimplifier ~ Find Valid Collapses"), STAT_PMUMeshSimplifier_FindValidCollapses, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUMeshSimplifier ~ Collapse Edges"), STAT_PMUMeshSimplifier_CollapseEdges, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUMeshSimplifier ~ Remove Triangles"), STAT_PMUMeshSimplifier_RemoveTriangles, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUMeshSimplifier ~ Remove Edges"), STAT_PMUMeshSimplifier_RemoveEdges, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUMeshSimplifier ~ Sort Edges"), STAT_PMUMeshSimplifier_SortEdges, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUMeshSimplifier ~ Simplify Edge Collapse"), STAT_PMUMeshSimplifier_SimplifyEdgeCollapse, STATGROUP_ProceduralMeshUtility);
+DECLARE_CYCLE_STAT(TEXT("PMUMeshSimplifier ~ Simplify Quadric"), STAT_PMUMeshSimplifier_SimplifyQuadric, STATGROUP_ProceduralMeshUtility);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Simplifier Input Triangles"), STAT_PMUMeshSimplifier_InputTriangles, STATGROUP_ProceduralMeshUtility);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Simplifier Output Triangles"), STAT_PMUMeshSimplifier_OutputTriangles, STATGROUP_ProceduralMeshUtility);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Simplifier Quadric Collapses"), STAT_PMUMeshSimplifier_QuadricCollapses, STATGROUP_ProceduralMeshUtility);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Simplifier Parallel Passes"), STAT_PMUMeshSimplifier_ParallelPasses, STATGROUP_ProceduralMeshUtility);
+
+#ifdef PMU_MESH_SIMPLIFIER_CHECK_DISTANCE
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Simplifier Hausdorff Distance"), STAT_PMUMeshSimplifier_HausdorffDistance, STATGROUP_ProceduralMeshUtility);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Simplifier RMS Distance"), STAT_PMUMeshSimplifier_RMSDistance, STATGROUP_ProceduralMeshUtility);
+#endif
+
+namespace PMUMeshSimplifier
+{
+    // Item count processed by a single compaction task
+    static const int32 COMPACT_BLOCK_SIZE = 4096;
+
+    // Order preserving compaction of items with non-zero keep flags.
+    // Items are split into blocks, block output offsets are the prefix
+    // sum of block kept item counts so blocks are written independently.
+    // Compacting into the source items is supported but always serial,
+    // kept items only ever move to lower indices. Block offsets are scratch
+    // storage reused across calls. Returns kept item count.
+
+    template<typename ItemType>
+    int32 CompactItems(
+        const ItemType* Items,
+        const int32 ItemCount,
+        const TArray<uint8>& KeepFlags,
+        ItemType* OutItems,
+        TArray<int32>& BlockOffsets,
+        bool bParallel
+        )
+    {
+        if (! bParallel || Items == OutItems)
+        {
+            int32 OutCount = 0;
+
+            for (int32 i=0; i<ItemCount; ++i)
+            {
+                if (KeepFlags[i])
+                {
+                    OutItems[OutCount++] = Items[i];
+                }
+            }
+
+            return OutCount;
+        }
+
+        const int32 BlockCount = FMath::DivideAndRoundUp(ItemCount, COMPACT_BLOCK_SIZE);
+
+        BlockOffsets.SetNumZeroed(BlockCount+1, false);
+
+        ParallelFor(BlockCount, [&](int32 b)
+        {
+            const int32 ItemStart = b * COMPACT_BLOCK_SIZE;
+            const int32 ItemEnd = FMath::Min(ItemStart + COMPACT_BLOCK_SIZE, ItemCount);
+            int32 KeepCount = 0;
+
+            for (int32 i=ItemStart; i<ItemEnd; ++i)
+            {
+                KeepCount += KeepFlags[i] ? 1 : 0;
+            }
+
+            BlockOffsets[b+1] = KeepCount;
+        },
+        ! bParallel);
+
+        for (int32 b=0; b<BlockCount; ++b)
+        {
+            BlockOffsets[b+1] += BlockOffsets[b];
+        }
+
+        ParallelFor(BlockCount, [&](int32 b)
+        {
+            const int32 ItemStart = b * COMPACT_BLOCK_SIZE;
+            const int32 ItemEnd = FMath::Min(ItemStart + COMPACT_BLOCK_SIZE, ItemCount);
+            int32 OutIndex = BlockOffsets[b];
+
+            for (int32 i=ItemStart; i<ItemEnd; ++i)
+            {
+                if (KeepFlags[i])
+                {
+                    OutItems[OutIndex++] = Items[i];
+                }
+            }
+        },
+        ! bParallel);
+
+        return BlockOffsets[BlockCount];
+    }
+
+    // Collapse cost key, lower error wins and ties are won by the lower
+    // edge index. Error bits are remapped so they order as signed integers.
+
+    FORCEINLINE int64 MakeCollapseKey(float Error, int32 EdgeIndex)
+    {
+        int32 ErrorBits = *reinterpret_cast<const int32*>(&Error);
+        ErrorBits = (ErrorBits < 0) ? (ErrorBits ^ 0x7FFFFFFF) : ErrorBits;
+        return (int64(ErrorBits) << 32) | int64(uint32(EdgeIndex));
+    }
+
+    FORCEINLINE void AtomicMin(volatile int64* Dest, int64 Value)
+    {
+        int64 Current = *Dest;
+
+        while (Value < Current)
+        {
+            const int64 Prev = FPlatformAtomics::InterlockedCompareExchange(Dest, Value, Current);
+
+            if (Prev == Current)
+            {
+                break;
+            }
+
+            Current = Prev;
+        }
+    }
+}
+
+void FPMUMeshSimplifier::FWorkspace::Empty()
+{
+    vertices.Empty();
+    triangles.Empty();
+    triBuffer.Empty();
+    edges.Empty();
+    edgeBuffer.Empty();
+    bucketOffsets.Empty();
+    boundaryVerts.Empty();
+    collapsePosition.Empty();
+    collapseNormal.Empty();
+    collapseValid.Empty();
+    collapseEdgeID.Empty();
+    collapseTarget.Empty();
+    vertexTriangleCounts.Empty();
+    randomEdges.Empty();
+    minCollapseKey.Empty();
+    keepFlags.Empty();
+    compactOffsets.Empty();
+    vertexRemap.Empty();
+    quadrics.Empty();
+    vertexRefStart.Empty();
+    vertexRefCount.Empty();
+    vertexRefs.Empty();
+    vertexLocked.Empty();
+    vertexMarks.Empty();
+    triRemoved.Empty();
+    heap.Empty();
+    heapIndex.Empty();
+    collapseCost.Empty();
+    triCollapseStep.Empty();
+    collapseRecords.Empty();
+}
+
+void FPMUMeshSimplifier::TrimWorkspace()
+{
+    if (workspaceTriangleCount > (WORKSPACE_TRIM_RATIO * lastTriangleCount))
+    {
+        EmptyWorkspace();
+    }
+}
+
+FPMUMeshSimplifier& FPMUMeshSimplifier::GetThreadSimplifier()
+{
+    static thread_local FPMUMeshSimplifier Simplifier;
+    return Simplifier;
+}
+
+#ifdef PMU_MESH_SIMPLIFIER_CHECK_DISTANCE
+namespace PMUMeshSimplifier
+{
+    // One-sided distance from the simplified surface to the input surface,
+    // sampled at simplified vertices and triangle centroids. Returns the
+    // maximum (one-sided Hausdorff) and root mean square sample distance.
+    //
+    // Input triangles are binned into a uniform grid by their bounds. A
+    // sample nearer than one cell to its closest triangle in the 3x3x3
+    // neighbourhood is exact, other samples test every input triangle.
+
+    void MeasureSurfaceDistance(
+        const TArray<FVector>& SrcPositions,
+        const TArray<int32>& SrcIndices,
+        const TArray<FVector>& Samples,
+        float& OutMaxDistance,
+        float& OutRMSDistance
+        )
+    {
+        OutMaxDistance = 0.f;
+        OutRMSDistance = 0.f;
+
+        const int32 SrcTriNum = SrcIndices.Num() / 3;
+
+        if (SrcTriNum < 1 || Samples.Num() < 1)
+        {
+            return;
+        }
+
+        FBox Bounds(SrcPositions);
+        float EdgeLength = 0.f;
+
+        for (int32 t=0; t<SrcTriNum; ++t)
+        {
+            EdgeLength += FVector::Dist(SrcPositions[SrcIndices[t*3]], SrcPositions[SrcIndices[t*3+1]]);
+        }
+
+        // Cells are about twice the average edge length, grid cell
+        // count is limited to the order of input triangle count
+
+        const FVector Size(Bounds.GetSize());
+        const float MaxCellCount = FMath::Max(SrcTriNum, 1024);
+
+        float CellSize = FMath::Max(2.f * EdgeLength / SrcTriNum, KINDA_SMALL_NUMBER);
+        const float CellCount = (Size.X/CellSize + 1.f) * (Size.Y/CellSize + 1.f) * (Size.Z/CellSize + 1.f);
+
+        if (CellCount > MaxCellCount)
+        {
+            CellSize *= FMath::Pow(CellCount / MaxCellCount, 1.f/3.f);
+        }
+
+        const FIntVector GridSize(
+            FMath::CeilToInt(Size.X / CellSize) + 1,
+            FMath::CeilToInt(Size.Y / CellSize) + 1,
+            FMath::CeilToInt(Size.Z / CellSize) + 1
+            );
+
+        auto GetCell = [&](const FVector& P)
+        {
+            const FVector C((P - Bounds.Min) / CellSize);
+            return FIntVector(
+                FMath::Clamp(FMath::FloorToInt(C.X), 0, GridSize.X-1),
+                FMath::Clamp(FMath::FloorToInt(C.Y), 0, GridSize.Y-1),
+                FMath::Clamp(FMath::FloorToInt(C.Z), 0, GridSize.Z-1)
+                );
+        };
+
+        auto GetCellIndex = [&](const FIntVector& C)
+        {
+            return (C.Z * GridSize.Y + C.Y) * GridSize.X + C.X;
+        };
+
+        TArray<TArray<int32>> Cells;
+        Cells.SetNum(GridSize.X * GridSize.Y * GridSize.Z);
+
+        for (int32 t=0; t<SrcTriNum; ++t)
+        {
+            const FVector& A(SrcPositions[SrcIndices[t*3  ]]);
+            const FVector& B(SrcPositions[SrcIndices[t*3+1]]);
+            const FVector& C(SrcPositions[SrcIndices[t*3+2]]);
+
+            const FIntVector C0(GetCell(A.ComponentMin(B).ComponentMin(C)));
+            const FIntVector C1(GetCell(A.ComponentMax(B).ComponentMax(C)));
+
+            for (int32 z=C0.Z; z<=C1.Z; ++z)
+            for (int32 y=C0.Y; y<=C1.Y; ++y)
+            for (int32 x=C0.X; x<=C1.X; ++x)
+            {
+                Cells[GetCellIndex(FIntVector(x, y, z))].Emplace(t);
+            }
+        }
+
+        auto GetTriangleDistSq = [&](const FVector& P, int32 t)
+        {
+            const FVector Q(FMath::ClosestPointOnTriangleToPoint(
+                P,
+                SrcPositions[SrcIndices[t*3  ]],
+                SrcPositions[SrcIndices[t*3+1]],
+                SrcPositions[SrcIndices[t*3+2]]
+                ));
+            return FVector::DistSquared(P, Q);
+        };
+
+        double SumDistSq = 0.0;
+        float MaxDistSq = 0.f;
+
+        for (const FVector& P : Samples)
+        {
+            const FIntVector Cell(GetCell(P));
+            float DistSq = TNumericLimits<float>::Max();
+
+            for (int32 z=FMath::Max(Cell.Z-1, 0); z<=FMath::Min(Cell.Z+1, GridSize.Z-1); ++z)
+            for (int32 y=FMath::Max(Cell.Y-1, 0); y<=FMath::Min(Cell.Y+1, GridSize.Y-1); ++y)
+            for (int32 x=FMath::Max(Cell.X-1, 0); x<=FMath::Min(Cell.X+1, GridSize.X-1); ++x)
+            {
+                for (int32 t : Cells[GetCellIndex(FIntVector(x, y, z))])
+                {
+                    DistSq = FMath::Min(DistSq, GetTriangleDistSq(P, t));
+                }
+            }
+
+            // Closest triangle could lie beyond the searched cells
+            if (DistSq > (CellSize * CellSize) || ! Bounds.IsInsideOrOn(P))
+            {
+                for (int32 t=0; t<SrcTriNum; ++t)
+                {
+                    DistSq = FMath::Min(DistSq, GetTriangleDistSq(P, t));
+                }
+            }
+
+            SumDistSq += DistSq;
+            MaxDistSq = FMath::Max(MaxDistSq, DistSq);
+        }
+
+        OutMaxDistance = FMath::Sqrt(MaxDistSq);
+        OutRMSDistance = FMath::Sqrt(static_cast<float>(SumDistSq / Samples.Num()));
+    }
+}
+#endif
+
 void FPMUMeshSimplifier::Simplify(
     FPMUMeshSection& mesh,
     const FVector& InWorldOffset,
     const FPMUMeshSimplifierOptions& InOptions
     )
 {
+    static_assert(sizeof(FTri) == (sizeof(int32)*3), "FTri must alias index buffer triangles");
+
     Options = InOptions;
 
     if (mesh.VertexBuffer.Num() < 16 || mesh.IndexBuffer.Num() < (16*3))
@@ -46,56 +364,179 @@ void FPMUMeshSimplifier::Simplify(
         return;
     }
 
-    const TArray<int32>& SrcIndexBuffer(mesh.IndexBuffer);
-
-    TArray<FVertex> vertices(mesh.VertexBuffer);
-    TArray<FTri> triangles;
+    FWorkspace& ws(Workspace);
 
+    const bool bInPlace = Options.bInPlace;
+    const bool bHasWorldOffset = ! InWorldOffset.IsZero();
     const int32 TriNum = mesh.IndexBuffer.Num() / 3;
-    triangles.SetNumUninitialized(TriNum);
 
-    for (int32 i=0; i<TriNum; ++i)
+    lastTriangleCount = TriNum;
+    workspaceTriangleCount = FMath::Max(workspaceTriangleCount, TriNum);
+
+    FVertexView vertices;
+    FTriView triangles;
+
+    if (bInPlace)
+    {
+        // Reinterpret section buffers, trailing indices of an
+        // incomplete triangle are discarded on output
+        vertices = FVertexView(mesh.VertexBuffer.GetData(), mesh.VertexBuffer.Num());
+        triangles = FTriView(reinterpret_cast<FTri*>(mesh.IndexBuffer.GetData()), TriNum);
+    }
+    else
     {
-        const int32 idx = i*3;
-        triangles[i].indices_[0] = SrcIndexBuffer[idx];
-        triangles[i].indices_[1] = SrcIndexBuffer[idx+1];
-        triangles[i].indices_[2] = SrcIndexBuffer[idx+2];
+        ws.vertices.Reset();
+        ws.vertices.Append(mesh.VertexBuffer);
+
+        ws.triangles.SetNumUninitialized(TriNum, false);
+        FMemory::Memcpy(ws.triangles.GetData(), mesh.IndexBuffer.GetData(), TriNum * sizeof(FTri));
+
+        vertices = FVertexView(ws.vertices.GetData(), ws.vertices.Num());
+        triangles = FTriView(ws.triangles.GetData(), TriNum);
     }
 
-    for (FVertex& v : vertices)
+    if (bHasWorldOffset)
     {
-        v.Position = v.Position - InWorldOffset;
+        for (FVertex& v : vertices)
+        {
+            v.Position = v.Position - InWorldOffset;
+        }
     }
 
     //mesh.numVertices = 0;
     //mesh.numTriangles = 0;
 
-    TArray<FEdge> edges;
-    edges.Reserve(triangles.Num() * 3);
+    INC_DWORD_STAT_BY(STAT_PMUMeshSimplifier_InputTriangles, TriNum);
 
-    BuildCandidateEdges(vertices, triangles, edges);
+#ifdef PMU_MESH_SIMPLIFIER_CHECK_DISTANCE
+    // In place simplification overwrites the input, keep a copy
+    TArray<FVector> SrcPositions;
+    TArray<int32> SrcIndices;
+
+    SrcPositions.Reserve(vertices.Num());
+    SrcIndices.SetNumUninitialized(TriNum * 3);
+
+    for (const FVertex& v : vertices)
+    {
+        SrcPositions.Emplace(v.Position);
+    }
+
+    FMemory::Memcpy(SrcIndices.GetData(), triangles.GetData(), TriNum * sizeof(FTri));
+#endif
+
+    if (Options.Method == EPMUMeshSimplifierMethod::QuadricPriorityQueue)
+    {
+        SimplifyQuadric(vertices, triangles);
+    }
+    else
+    {
+        SimplifyEdgeCollapse(vertices, triangles);
+    }
+
+    INC_DWORD_STAT_BY(STAT_PMUMeshSimplifier_OutputTriangles, triangles.Num());
+
+    //CompactVertices(vertices, mesh);
+    CompactVertices(vertices, triangles);
+
+#ifdef PMU_MESH_SIMPLIFIER_CHECK_DISTANCE
+    // Compare simplifier backends by distance to the input surface
+    {
+        TArray<FVector> Samples;
+        Samples.Reserve(vertices.Num() + triangles.Num());
+
+        for (const FVertex& v : vertices)
+        {
+            Samples.Emplace(v.Position);
+        }
 
-    TArray<FVector> collapsePosition;
-    TArray<FVector> collapseNormal;
-    TArray<int32> collapseValid;
-    TArray<int32> collapseEdgeID;
-    TArray<int32> collapseTarget;
+        const int32* Indices = reinterpret_cast<const int32*>(triangles.GetData());
 
-    collapsePosition.SetNumUninitialized(edges.Num());
-    collapseNormal.SetNumUninitialized(edges.Num());
-    collapseValid.Reserve(edges.Num());
-    collapseEdgeID.Reserve(vertices.Num());
-    collapseTarget.Reserve(vertices.Num());
+        for (int32 t=0; t<triangles.Num(); ++t)
+        {
+            Samples.Emplace((
+                vertices[Indices[t*3  ]].Position +
+                vertices[Indices[t*3+1]].Position +
+                vertices[Indices[t*3+2]].Position) / 3.f);
+        }
+
+        float MaxDistance;
+        float RMSDistance;
+        PMUMeshSimplifier::MeasureSurfaceDistance(SrcPositions, SrcIndices, Samples, MaxDistance, RMSDistance);
+
+        SET_FLOAT_STAT(STAT_PMUMeshSimplifier_HausdorffDistance, MaxDistance);
+        SET_FLOAT_STAT(STAT_PMUMeshSimplifier_RMSDistance, RMSDistance);
+
+        UE_LOG(LogPMU,Log, TEXT("FPMUMeshSimplifier::Simplify() %s %d -> %d triangles, Hausdorff distance %f, RMS distance %f"),
+            Options.Method == EPMUMeshSimplifierMethod::QuadricPriorityQueue ? TEXT("Quadric") : TEXT("EdgeCollapse"),
+            TriNum,
+            triangles.Num(),
+            MaxDistance,
+            RMSDistance
+            );
+    }
+#endif
+
+    //mesh.numVertices = vertices.Num();
+
+    TArray<FVertex>& DstVertexBuffer(mesh.VertexBuffer);
+    TArray<int32>& DstIndexBuffer(mesh.IndexBuffer);
+
+    if (bInPlace)
+    {
+        if (bHasWorldOffset)
+        {
+            for (FVertex& v : vertices)
+            {
+                v.Position = v.Position + InWorldOffset;
+            }
+        }
+
+        DstVertexBuffer.SetNum(vertices.Num(), false);
+        DstIndexBuffer.SetNum(triangles.Num()*3, false);
+
+        return;
+    }
+
+    DstVertexBuffer.SetNumUninitialized(vertices.Num(), false);
+    DstIndexBuffer.SetNumUninitialized(triangles.Num()*3, false);
+
+    for (int32 i=0; i<vertices.Num(); i++)
+    {
+        DstVertexBuffer[i].Position = vertices[i].Position + InWorldOffset;
+        DstVertexBuffer[i].Normal = vertices[i].Normal;
+        DstVertexBuffer[i].Color = vertices[i].Color;
+    }
+
+    FMemory::Memcpy(DstIndexBuffer.GetData(), triangles.GetData(), triangles.Num() * sizeof(FTri));
+}
 
-    TArray<FEdge> edgeBuffer;
-    TArray<FTri> triBuffer;
+void FPMUMeshSimplifier::SimplifyEdgeCollapse(FVertexView& vertices, FTriView& triangles)
+{
+    SCOPE_CYCLE_COUNTER(STAT_PMUMeshSimplifier_SimplifyEdgeCollapse);
+
+    FWorkspace& ws(Workspace);
+
+    bParallel = Options.bParallelPasses && triangles.Num() >= PARALLEL_MIN_TRIANGLES;
+
+    TArray<FEdge>& edges(ws.edges);
 
-    edgeBuffer.Reserve(edges.Num());
-    triBuffer.Reserve(triangles.Num());
+    BuildCandidateEdges(vertices, triangles, edges);
+
+    TArray<FVector>& collapsePosition(ws.collapsePosition);
+    TArray<FVector>& collapseNormal(ws.collapseNormal);
+    TArray<int32>& collapseValid(ws.collapseValid);
+    TArray<int32>& collapseEdgeID(ws.collapseEdgeID);
+    TArray<int32>& collapseTarget(ws.collapseTarget);
+
+    collapsePosition.SetNumUninitialized(edges.Num(), false);
+    collapseNormal.SetNumUninitialized(edges.Num(), false);
+    collapseEdgeID.SetNumUninitialized(vertices.Num(), false);
+    collapseTarget.SetNumUninitialized(vertices.Num(), false);
 
     // per vertex
-    TArray<int32> vertexTriangleCounts;
-    vertexTriangleCounts.SetNumZeroed(vertices.Num());
+    TArray<int32>& vertexTriangleCounts(ws.vertexTriangleCounts);
+    vertexTriangleCounts.Reset();
+    vertexTriangleCounts.SetNumZeroed(vertices.Num(), false);
 
     for (int32 j=0; j<triangles.Num(); j++)
     {
@@ -115,15 +556,13 @@ void FPMUMeshSimplifier::Simplify(
            iterations++ < maxIterations
            )
     {
-        collapseEdgeID.Init(-1, vertices.Num());
-        collapseTarget.Init(-1, vertices.Num());
+        FMemory::Memset(collapseTarget.GetData(), 0xFF, collapseTarget.Num() * collapseTarget.GetTypeSize());
 
         collapseValid.Reset();
 
         const int32 countValidCollapse = FindValidCollapses(
             edges,
             vertices,
-            triangles,
             vertexTriangleCounts,
             collapseValid, 
             collapseEdgeID,
@@ -146,70 +585,80 @@ void FPMUMeshSimplifier::Simplify(
             collapseTarget
             );
 
-        RemoveTriangles(vertices, collapseTarget, triangles, triBuffer, vertexTriangleCounts);
-        RemoveEdges(collapseTarget, edges, edgeBuffer);
+        RemoveTriangles(collapseTarget, triangles, vertexTriangleCounts);
+        RemoveEdges(collapseTarget, edges, ws.edgeBuffer);
     }
+}
 
-    //mesh.numTriangles = 0;
-    //for (int32 i=0; i<triangles.Num(); i++)
-    //{
-    //    mesh.triangles[mesh.numTriangles].indices_[0] = triangles[i].indices_[0];
-    //    mesh.triangles[mesh.numTriangles].indices_[1] = triangles[i].indices_[1];
-    //    mesh.triangles[mesh.numTriangles].indices_[2] = triangles[i].indices_[2];
-    //    mesh.numTriangles++;
-    //}
+void FPMUMeshSimplifier::SortEdges(TArray<FEdge>& edges, const int32 vertexCount)
+{
+    SCOPE_CYCLE_COUNTER(STAT_PMUMeshSimplifier_SortEdges);
 
-    //CompactVertices(vertices, mesh);
-    CompactVertices(vertices, triangles);
+    // Two pass LSD radix sort with one bucket per vertex. Edges are sorted
+    // by min_ then by max_, which matches ascending idx_ order since max_
+    // occupies the upper half of idx_.
 
-    //mesh.numVertices = vertices.Num();
+    const int32 edgeCount = edges.Num();
 
-    TArray<FVertex>& DstVertexBuffer(mesh.VertexBuffer);
-    TArray<int32>& DstIndexBuffer(mesh.IndexBuffer);
+    TArray<FEdge>& edgeBuffer(Workspace.edgeBuffer);
+    TArray<int32>& bucketOffsets(Workspace.bucketOffsets);
 
-    DstVertexBuffer.SetNumUninitialized(vertices.Num(), true);
-    DstIndexBuffer.SetNumUninitialized(triangles.Num()*3, true);
+    edgeBuffer.SetNumUninitialized(edgeCount, false);
+    bucketOffsets.SetNumUninitialized(vertexCount, false);
 
-    for (int32 i=0; i<vertices.Num(); i++)
+    for (int32 pass=0; pass<2; ++pass)
     {
-        DstVertexBuffer[i].Position = vertices[i].Position + InWorldOffset;
-        DstVertexBuffer[i].Normal = vertices[i].Normal;
-        DstVertexBuffer[i].Color = vertices[i].Color;
-    }
+        const TArray<FEdge>& src(pass == 0 ? edges : edgeBuffer);
+        TArray<FEdge>& dst(pass == 0 ? edgeBuffer : edges);
 
-    for (int32 i=0; i<triangles.Num(); i++)
-    {
-        const int32 idx = i*3;
-        DstIndexBuffer[idx]   = triangles[i].indices_[0];
-        DstIndexBuffer[idx+1] = triangles[i].indices_[1];
-        DstIndexBuffer[idx+2] = triangles[i].indices_[2];
+        FMemory::Memzero(bucketOffsets.GetData(), vertexCount * bucketOffsets.GetTypeSize());
+
+        for (int32 i=0; i<edgeCount; ++i)
+        {
+            const FEdge& edge(src[i]);
+            ++bucketOffsets[pass == 0 ? edge.min_ : edge.max_];
+        }
+
+        for (int32 v=0, offset=0; v<vertexCount; ++v)
+        {
+            const int32 count = bucketOffsets[v];
+            bucketOffsets[v] = offset;
+            offset += count;
+        }
+
+        for (int32 i=0; i<edgeCount; ++i)
+        {
+            const FEdge& edge(src[i]);
+            dst[bucketOffsets[pass == 0 ? edge.min_ : edge.max_]++] = edge;
+        }
     }
 }
 
 void FPMUMeshSimplifier::BuildCandidateEdges(
-    const TArray<FVertex>& vertices,
-    const TArray<FTri>& triangles,
+    const FVertexView& vertices,
+    const FTriView& triangles,
     TArray<FEdge>& edges
     )
 {
+    edges.SetNumUninitialized(triangles.Num() * 3, false);
+
     for (int32 i=0; i<triangles.Num(); i++)
     {
         const int32* indices = triangles[i].indices_;
-        edges.Emplace(FMath::Min(indices[0], indices[1]), FMath::Max(indices[0], indices[1]));
-        edges.Emplace(FMath::Min(indices[1], indices[2]), FMath::Max(indices[1], indices[2]));
-        edges.Emplace(FMath::Min(indices[0], indices[2]), FMath::Max(indices[0], indices[2]));
+        FEdge* triEdges = edges.GetData() + i*3;
+        triEdges[0] = FEdge(FMath::Min(indices[0], indices[1]), FMath::Max(indices[0], indices[1]));
+        triEdges[1] = FEdge(FMath::Min(indices[1], indices[2]), FMath::Max(indices[1], indices[2]));
+        triEdges[2] = FEdge(FMath::Min(indices[0], indices[2]), FMath::Max(indices[0], indices[2]));
     }
 
-    edges.Sort(
-        [](const FEdge& lhs, const FEdge& rhs)
-        {
-            return lhs.idx_ < rhs.idx_;
-        } );
+    SortEdges(edges, vertices.Num());
 
-    TArray<FEdge> filteredEdges;
-    TArray<bool> boundaryVerts;
+    // Sorted edges are no longer needed in the edge buffer,
+    // reuse its allocation for the filtered edge list
+    TArray<FEdge>& filteredEdges(Workspace.edgeBuffer);
+    TArray<bool>& boundaryVerts(Workspace.boundaryVerts);
 
-    filteredEdges.Reserve(edges.Num());
+    filteredEdges.Reset();
     boundaryVerts.Init(false, vertices.Num());
 
     FEdge prev = edges[0];
@@ -253,8 +702,7 @@ void FPMUMeshSimplifier::BuildCandidateEdges(
 
 int32 FPMUMeshSimplifier::FindValidCollapses(
     const TArray<FEdge>& edges,
-    const TArray<FVertex>& vertices,
-    const TArray<FTri>& tris,
+    const FVertexView& vertices,
     const TArray<int32>& vertexTriangleCounts,
     TArray<int32>& collapseValid, 
     TArray<int32>& collapseEdgeID, 
@@ -262,7 +710,7 @@ int32 FPMUMeshSimplifier::FindValidCollapses(
     TArray<FVector>& collapseNormal
     )
 {
-    int32 validCollapses = 0;
+    SCOPE_CYCLE_COUNTER(STAT_PMUMeshSimplifier_FindValidCollapses);
 
     std::mt19937 prng;
     prng.seed(42);
@@ -270,22 +718,46 @@ int32 FPMUMeshSimplifier::FindValidCollapses(
     const int32 numRandomEdges = edges.Num() * Options.EdgeFraction;
     std::uniform_int_distribution<int32> distribution(0, (int32)(edges.Num() - 1));
 
-    TArray<int32> randomEdges;
-    randomEdges.Reserve(numRandomEdges);
+    TArray<int32>& randomEdges(Workspace.randomEdges);
+    randomEdges.Reset();
 
     for (int32 i=0; i<numRandomEdges; i++)
     {
         randomEdges.Emplace(distribution(prng));
     }
 
-    // Sort the edges to improve locality
+    // Sort the edges to improve locality. Duplicate edges evaluate to
+    // the same collapse and are removed so that each candidate edge
+    // writes its collapse data exactly once.
     randomEdges.Sort();
 
-    TArray<float> minEdgeCost;
-    minEdgeCost.Init(BIG_NUMBER, vertices.Num());
+    {
+        int32 uniqueCount = 0;
+
+        for (int32 i=0; i<randomEdges.Num(); i++)
+        {
+            if (i == 0 || randomEdges[i] != randomEdges[uniqueCount-1])
+            {
+                randomEdges[uniqueCount++] = randomEdges[i];
+            }
+        }
+
+        randomEdges.SetNum(uniqueCount, false);
+    }
+
+    // Every vertex keeps the minimum collapse key of its candidate edges,
+    // the winning edge is the one with the lowest error and edge index
+
+    TArray<int64>& minCollapseKey(Workspace.minCollapseKey);
+    TArray<uint8>& candidateValid(Workspace.keepFlags);
 
-    for (int32 i : randomEdges)
+    minCollapseKey.Init(MAX_int64, vertices.Num());
+    candidateValid.Reset();
+    candidateValid.SetNumZeroed(randomEdges.Num(), false);
+
+    ParallelFor(randomEdges.Num(), [&](int32 ci)
     {
+        const int32 i = randomEdges[ci];
         const FEdge& edge(edges[i]);
         const FVertex& vMin(vertices[edge.min_]);
         const FVertex& vMax(vertices[edge.max_]);
@@ -294,25 +766,25 @@ int32 FPMUMeshSimplifier::FindValidCollapses(
         const float cosAngle = vMin.Normal | vMax.Normal;
         if (cosAngle < Options.MinAngleCosine)
         {
-            continue;
+            return;
         }
 
         // Prevent collapses above maximum edge size
         const float edgeSize = (vMax.Position - vMin.Position).SizeSquared();
         if (edgeSize > (Options.MaxEdgeSize * Options.MaxEdgeSize))
         {
-            continue;
+            return;
         }
 
         //if (FMath::abs(vMin.colour[3] - vMax.colour[3]) > 1e-3)
         //{
-        //    continue;
+        //    return;
         //}
 
         const int32 degree = vertexTriangleCounts[edge.min_] + vertexTriangleCounts[edge.max_];
         if (degree > COLLAPSE_MAX_DEGREE)
         {
-            continue;
+            return;
         }
 
         //__declspec(align(16)) float pos[4];
@@ -335,30 +807,46 @@ int32 FPMUMeshSimplifier::FindValidCollapses(
 
         if (error > Options.MaxError)
         {
-            continue;
+            return;
         }
 
-        collapseValid.Emplace(i);
+        candidateValid[ci] = 1;
 
         collapseNormal[i] = (vMin.Normal+vMax.Normal) * 0.5f;
         collapsePosition[i] = pos;
 
-        if (error < minEdgeCost[edge.min_])
-        {
-            minEdgeCost[edge.min_] = error;
-            collapseEdgeID[edge.min_] = i;
-        }
+        const int64 key = PMUMeshSimplifier::MakeCollapseKey(error, i);
+        PMUMeshSimplifier::AtomicMin(&minCollapseKey[edge.min_], key);
+        PMUMeshSimplifier::AtomicMin(&minCollapseKey[edge.max_], key);
+    },
+    ! bParallel);
 
-        if (error < minEdgeCost[edge.max_])
-        {
-            minEdgeCost[edge.max_] = error;
-            collapseEdgeID[edge.max_] = i;
-        }
+    collapseValid.SetNumUninitialized(randomEdges.Num(), false);
+
+    const int32 validCount = PMUMeshSimplifier::CompactItems(
+        randomEdges.GetData(),
+        randomEdges.Num(),
+        candidateValid,
+        collapseValid.GetData(),
+        Workspace.compactOffsets,
+        bParallel
+        );
+
+    collapseValid.SetNum(validCount, false);
+
+    ParallelFor(vertices.Num(), [&](int32 v)
+    {
+        const int64 key = minCollapseKey[v];
+        collapseEdgeID[v] = (key != MAX_int64) ? int32(uint32(key & 0xFFFFFFFF)) : -1;
+    },
+    ! bParallel);
 
-        validCollapses++;
+    if (bParallel)
+    {
+        INC_DWORD_STAT(STAT_PMUMeshSimplifier_ParallelPasses);
     }
 
-    return validCollapses;
+    return collapseValid.Num();
 }
 
 void FPMUMeshSimplifier::CollapseEdges(
@@ -367,47 +855,47 @@ void FPMUMeshSimplifier::CollapseEdges(
     const TArray<int32>& collapseEdgeID,
     const TArray<FVector>& collapsePositions,
     const TArray<FVector>& collapseNormal,
-    TArray<FVertex>& vertices,
+    FVertexView& vertices,
     TArray<int32>& collapseTarget
     )
 {
-    int32 countCollapsed = 0;
-    int32 countCandidates = 0;
+    SCOPE_CYCLE_COUNTER(STAT_PMUMeshSimplifier_CollapseEdges);
 
-    for (int32 i: collapseValid)
+    // An edge only collapses if it won both of its vertices,
+    // collapsing edges never share a vertex
+
+    ParallelFor(collapseValid.Num(), [&](int32 ci)
     {
+        const int32 i = collapseValid[ci];
         const FEdge& edge(edges[i]);
 
-        countCandidates++;
-
         if (collapseEdgeID[edge.min_] == i && collapseEdgeID[edge.max_] == i)
         {
-            countCollapsed++;
-
             collapseTarget[edge.max_] = edge.min_;
             vertices[edge.min_].Position = collapsePositions[i];
             vertices[edge.min_].Normal = collapseNormal[i];
         }
-    }
+    },
+    ! bParallel);
 }
 
 int32 FPMUMeshSimplifier::RemoveTriangles(
-    const TArray<FVertex>& vertices,
     const TArray<int32>& collapseTarget,
-    TArray<FTri>& tris,
-    TArray<FTri>& triBuffer,
+    FTriView& tris,
     TArray<int32>& vertexTriangleCounts
     )
 {
-    int32 removedCount = 0;
+    SCOPE_CYCLE_COUNTER(STAT_PMUMeshSimplifier_RemoveTriangles);
 
-    vertexTriangleCounts.Reset();
-    vertexTriangleCounts.SetNumZeroed(vertices.Num());
+    FMemory::Memzero(vertexTriangleCounts.GetData(), vertexTriangleCounts.Num() * vertexTriangleCounts.GetTypeSize());
 
-    triBuffer.Reset();
+    TArray<uint8>& triKeep(Workspace.keepFlags);
+    triKeep.SetNumUninitialized(tris.Num(), false);
 
-    for (FTri& tri: tris)
+    ParallelFor(tris.Num(), [&](int32 ti)
     {
+        FTri& tri(tris[ti]);
+
         for (int32 j=0; j<3; j++)
         {
             const int32 t = collapseTarget[tri.indices_[j]];
@@ -423,20 +911,47 @@ int32 FPMUMeshSimplifier::RemoveTriangles(
             tri.indices_[1] == tri.indices_[2]
             )
         {
-            removedCount++;
-            continue;
+            triKeep[ti] = 0;
+            return;
         }
 
         const int32* indices = tri.indices_;
         for (int32 index=0; index<3; index++)
         {
-            vertexTriangleCounts[indices[index]] += 1;
+            FPlatformAtomics::InterlockedIncrement(&vertexTriangleCounts[indices[index]]);
         }
 
-        triBuffer.Emplace(tri);
+        triKeep[ti] = 1;
+    },
+    ! bParallel);
+
+    // Compact into the triangle buffer for parallel compaction unless
+    // simplifying in-place, triangles are otherwise compacted in-place
+
+    FTri* dstTris = tris.GetData();
+
+    if (bParallel && ! Options.bInPlace)
+    {
+        TArray<FTri>& triBuffer(Workspace.triBuffer);
+        triBuffer.SetNumUninitialized(tris.Num(), false);
+        dstTris = triBuffer.GetData();
+
+        // Buffer now holds the current triangle array allocation
+        Swap(triBuffer, Workspace.triangles);
     }
 
-    Swap(tris, triBuffer);
+    const int32 keepCount = PMUMeshSimplifier::CompactItems(
+        tris.GetData(),
+        tris.Num(),
+        triKeep,
+        dstTris,
+        Workspace.compactOffsets,
+        bParallel
+        );
+
+    const int32 removedCount = tris.Num() - keepCount;
+
+    tris = FTriView(dstTris, keepCount);
 
     return removedCount;
 }
@@ -447,9 +962,15 @@ void FPMUMeshSimplifier::RemoveEdges(
     TArray<FEdge>& edgeBuffer
     )
 {
-    edgeBuffer.Reset();
-    for (FEdge& edge: edges)
+    SCOPE_CYCLE_COUNTER(STAT_PMUMeshSimplifier_RemoveEdges);
+
+    TArray<uint8>& edgeKeep(Workspace.keepFlags);
+    edgeKeep.SetNumUninitialized(edges.Num(), false);
+
+    ParallelFor(edges.Num(), [&](int32 ei)
     {
+        FEdge& edge(edges[ei]);
+
         int32 t = collapseTarget[edge.min_];
         if (t != -1)
         {
@@ -462,44 +983,58 @@ void FPMUMeshSimplifier::RemoveEdges(
             edge.max_ = t;
         }
 
-        if (edge.min_ != edge.max_)
-        {
-            edgeBuffer.Emplace(edge);
-        }
-    }
+        edgeKeep[ei] = (edge.min_ != edge.max_) ? 1 : 0;
+    },
+    ! bParallel);
+
+    edgeBuffer.SetNumUninitialized(edges.Num(), false);
+
+    const int32 keepCount = PMUMeshSimplifier::CompactItems(
+        edges.GetData(),
+        edges.Num(),
+        edgeKeep,
+        edgeBuffer.GetData(),
+        Workspace.compactOffsets,
+        bParallel
+        );
+
+    edgeBuffer.SetNumUninitialized(keepCount, false);
 
     Swap(edges, edgeBuffer);
 }
 
-void FPMUMeshSimplifier::CompactVertices(
-	TArray<FVertex>& vertices,
-    TArray<FTri>& triangles
+int32 FPMUMeshSimplifier::CompactVertices(
+    FVertexView& vertices,
+    FTriView& triangles
     )
 {
-	TArray<bool> vertexUsed;
-	vertexUsed.Init(false, vertices.Num());
+    // Vertices are compacted in-place, used vertices only ever move
+    // to lower indices so the remap is built in the same pass
+
+	TArray<int32>& remappedVertexIndices(Workspace.vertexRemap);
+	remappedVertexIndices.Init(-1, vertices.Num());
 
 	for (int32 i=0; i<triangles.Num(); i++)
 	{
 		const FTri& tri(triangles[i]);
 
-		vertexUsed[tri.indices_[0]] = true;
-		vertexUsed[tri.indices_[1]] = true;
-		vertexUsed[tri.indices_[2]] = true;
+		remappedVertexIndices[tri.indices_[0]] = 0;
+		remappedVertexIndices[tri.indices_[1]] = 0;
+		remappedVertexIndices[tri.indices_[2]] = 0;
 	}
 
-	TArray<FVertex> compactVertices;
-	TArray<int32> remappedVertexIndices;
-
-    compactVertices.Reserve(vertices.Num());
-	remappedVertexIndices.Init(-1, vertices.Num());
+    int32 compactCount = 0;
 
 	for (int32 i=0; i<vertices.Num(); i++)
 	{
-		if (vertexUsed[i])
+		if (remappedVertexIndices[i] >= 0)
 		{
-			remappedVertexIndices[i] = compactVertices.Num();
-			compactVertices.Emplace(vertices[i]);
+            if (compactCount != i)
+            {
+                vertices[compactCount] = vertices[i];
+            }
+
+			remappedVertexIndices[i] = compactCount++;
 		}
 	}
 
@@ -514,6 +1049,1022 @@ void FPMUMeshSimplifier::CompactVertices(
 		}
 	}
 
-	//Swap(vertices, compactVertices);
-    vertices = MoveTemp(compactVertices);
+    vertices = FVertexView(vertices.GetData(), compactCount);
+
+    return compactCount;
+}
+
+// Quadric Priority Queue Backend
+
+namespace PMUMeshSimplifier
+{
+    // Minimum normal cosine between a triangle and its collapsed
+    // counterpart, lower values are considered folded over
+    static const double QUADRIC_FLIP_MIN_COSINE = 0.2;
+
+    // Binary min heap of vertices keyed by their best collapse cost,
+    // vertex heap positions are tracked so keys can be updated in place
+
+    struct FCollapseHeap
+    {
+        TArray<int32>& Heap;
+        TArray<int32>& HeapIndex;
+        const TArray<double>& Keys;
+
+        FCollapseHeap(TArray<int32>& InHeap, TArray<int32>& InHeapIndex, const TArray<double>& InKeys)
+            : Heap(InHeap)
+            , HeapIndex(InHeapIndex)
+            , Keys(InKeys)
+        {
+        }
+
+        // Ties resolve to the lower vertex index for deterministic output
+        FORCEINLINE bool Less(int32 a, int32 b) const
+        {
+            return Keys[a] < Keys[b] || (Keys[a] == Keys[b] && a < b);
+        }
+
+        FORCEINLINE void Place(int32 i, int32 v)
+        {
+            Heap[i] = v;
+            HeapIndex[v] = i;
+        }
+
+        void SiftUp(int32 i)
+        {
+            const int32 v = Heap[i];
+
+            while (i > 0)
+            {
+                const int32 parent = (i-1) / 2;
+
+                if (! Less(v, Heap[parent]))
+                {
+                    break;
+                }
+
+                Place(i, Heap[parent]);
+                i = parent;
+            }
+
+            Place(i, v);
+        }
+
+        void SiftDown(int32 i)
+        {
+            const int32 v = Heap[i];
+            const int32 num = Heap.Num();
+
+            while (true)
+            {
+                int32 child = i*2 + 1;
+
+                if (child >= num)
+                {
+                    break;
+                }
+
+                if ((child+1) < num && Less(Heap[child+1], Heap[child]))
+                {
+                    ++child;
+                }
+
+                if (! Less(Heap[child], v))
+                {
+                    break;
+                }
+
+                Place(i, Heap[child]);
+                i = child;
+            }
+
+            Place(i, v);
+        }
+
+        FORCEINLINE bool IsEmpty() const
+        {
+            return Heap.Num() == 0;
+        }
+
+        FORCEINLINE int32 Top() const
+        {
+            return Heap[0];
+        }
+
+        // Insert vertex or restore heap order after its key changed
+        void Update(int32 v)
+        {
+            int32 i = HeapIndex[v];
+
+            if (i == INDEX_NONE)
+            {
+                i = Heap.Num();
+                Heap.Emplace(v);
+                HeapIndex[v] = i;
+            }
+
+            SiftUp(i);
+            SiftDown(HeapIndex[v]);
+        }
+
+        void Remove(int32 v)
+        {
+            const int32 i = HeapIndex[v];
+
+            if (i == INDEX_NONE)
+            {
+                return;
+            }
+
+            const int32 last = Heap.Pop(false);
+            HeapIndex[v] = INDEX_NONE;
+
+            if (last != v)
+            {
+                Place(i, last);
+                SiftUp(i);
+                SiftDown(HeapIndex[last]);
+            }
+        }
+    };
+}
+
+void FPMUMeshSimplifier::FQuadric::Reset()
+{
+    FMemory::Memzero(this, sizeof(FQuadric));
+}
+
+void FPMUMeshSimplifier::FQuadric::AddPlane(const FVector& n, const FVector& p)
+{
+    const double nx = n.X;
+    const double ny = n.Y;
+    const double nz = n.Z;
+    const double d = nx*p.X + ny*p.Y + nz*p.Z;
+
+    a00 += nx*nx; a01 += nx*ny; a02 += nx*nz;
+    a11 += ny*ny; a12 += ny*nz;
+    a22 += nz*nz;
+
+    b0 += d*nx;
+    b1 += d*ny;
+    b2 += d*nz;
+    c  += d*d;
+
+    px += p.X;
+    py += p.Y;
+    pz += p.Z;
+    count += 1.0;
+}
+
+void FPMUMeshSimplifier::FQuadric::Add(const FQuadric& q)
+{
+    a00 += q.a00; a01 += q.a01; a02 += q.a02;
+    a11 += q.a11; a12 += q.a12;
+    a22 += q.a22;
+
+    b0 += q.b0;
+    b1 += q.b1;
+    b2 += q.b2;
+    c  += q.c;
+
+    px += q.px;
+    py += q.py;
+    pz += q.pz;
+    count += q.count;
+}
+
+double FPMUMeshSimplifier::FQuadric::Evaluate(const FVector& v) const
+{
+    const double x = v.X;
+    const double y = v.Y;
+    const double z = v.Z;
+
+    // x'Ax - 2b'x + c
+    const double xAx =
+        a00*x*x + a11*y*y + a22*z*z +
+        2.0 * (a01*x*y + a02*x*z + a12*y*z);
+
+    const double bx = b0*x + b1*y + b2*z;
+
+    return FMath::Max(0.0, xAx - 2.0*bx + c);
+}
+
+FVector FPMUMeshSimplifier::FQuadric::Solve() const
+{
+    // Solve through the SVD pseudo inverse of the QEF solver,
+    // degenerate directions fall back to the quadric mass point
+
+    Mat4x4 ATA;
+    ATA.row[0] = _mm_set_ps(0.f, float(a02), float(a01), float(a00));
+    ATA.row[1] = _mm_set_ps(0.f, float(a12), float(a11), float(a01));
+    ATA.row[2] = _mm_set_ps(0.f, float(a22), float(a12), float(a02));
+    ATA.row[3] = _mm_setzero_ps();
+
+    const __m128 ATb = _mm_set_ps(0.f, float(b2), float(b1), float(b0));
+    const __m128 pointaccum = _mm_set_ps(float(count), float(pz), float(py), float(px));
+
+    __m128 x;
+    qef_simd_solve(ATA, ATb, pointaccum, x);
+
+    float solved[4];
+    _mm_storeu_ps(solved, x);
+
+    return FVector(solved[0], solved[1], solved[2]);
+}
+
+uint32 FPMUMeshSimplifier::NextMarkStamp()
+{
+    // Reset marks on stamp wrap around
+    if (++markStamp == 0)
+    {
+        FMemory::Memzero(Workspace.vertexMarks.GetData(), Workspace.vertexMarks.Num() * Workspace.vertexMarks.GetTypeSize());
+        markStamp = 1;
+    }
+
+    return markStamp;
+}
+
+void FPMUMeshSimplifier::BuildQuadricConnectivity(const FVertexView& vertices, const FTriView& triangles)
+{
+    FWorkspace& ws(Workspace);
+
+    const int32 vertexCount = vertices.Num();
+    const int32 triCount = triangles.Num();
+
+    // Vertex quadrics from incident triangle planes
+
+    ws.quadrics.SetNumUninitialized(vertexCount, false);
+
+    for (FQuadric& q : ws.quadrics)
+    {
+        q.Reset();
+    }
+
+    for (int32 t=0; t<triCount; ++t)
+    {
+        const int32* indices = triangles[t].indices_;
+        const FVector& p0(vertices[indices[0]].Position);
+        const FVector& p1(vertices[indices[1]].Position);
+        const FVector& p2(vertices[indices[2]].Position);
+
+        const FVector n = ((p1-p0) ^ (p2-p0)).GetSafeNormal();
+
+        for (int32 k=0; k<3; ++k)
+        {
+            ws.quadrics[indices[k]].AddPlane(n, vertices[indices[k]].Position);
+        }
+    }
+
+    // Vertex corner ranges, reserved with room for collapse rewrites
+
+    ws.vertexRefStart.SetNumUninitialized(vertexCount, false);
+    ws.vertexRefCount.Reset();
+    ws.vertexRefCount.SetNumZeroed(vertexCount, false);
+
+    for (int32 t=0; t<triCount; ++t)
+    {
+        for (int32 k=0; k<3; ++k)
+        {
+            ++ws.vertexRefCount[triangles[t].indices_[k]];
+        }
+    }
+
+    for (int32 v=0, offset=0; v<vertexCount; ++v)
+    {
+        ws.vertexRefStart[v] = offset;
+        offset += ws.vertexRefCount[v];
+        ws.vertexRefCount[v] = 0;
+    }
+
+    ws.vertexRefs.Reset();
+    ws.vertexRefs.Reserve(triCount * 6);
+    ws.vertexRefs.SetNumUninitialized(triCount * 3, false);
+
+    for (int32 t=0; t<triCount; ++t)
+    {
+        for (int32 k=0; k<3; ++k)
+        {
+            const int32 v = triangles[t].indices_[k];
+            ws.vertexRefs[ws.vertexRefStart[v] + ws.vertexRefCount[v]++] = t*3 + k;
+        }
+    }
+
+    // Lock vertices of boundary and non-manifold edges
+    // so that section borders stay in place
+
+    TArray<FEdge>& edges(ws.edges);
+    edges.SetNumUninitialized(triCount * 3, false);
+
+    for (int32 t=0; t<triCount; ++t)
+    {
+        const int32* indices = triangles[t].indices_;
+
+        for (int32 k=0; k<3; ++k)
+        {
+            const int32 i0 = indices[k];
+            const int32 i1 = indices[(k+1) % 3];
+            edges[t*3 + k] = FEdge(FMath::Min(i0, i1), FMath::Max(i0, i1));
+        }
+    }
+
+    SortEdges(edges, vertexCount);
+
+    ws.vertexLocked.Reset();
+    ws.vertexLocked.SetNumZeroed(vertexCount, false);
+
+    for (int32 i=0; i<edges.Num(); )
+    {
+        int32 j = i+1;
+
+        while (j < edges.Num() && edges[j].idx_ == edges[i].idx_)
+        {
+            ++j;
+        }
+
+        if ((j-i) != 2)
+        {
+            ws.vertexLocked[edges[i].min_] = 1;
+            ws.vertexLocked[edges[i].max_] = 1;
+        }
+
+        i = j;
+    }
+
+    ws.triRemoved.Reset();
+    ws.triRemoved.SetNumZeroed(triCount, false);
+
+    if (bRecordCollapses)
+    {
+        ws.triCollapseStep.Init(MAX_int32, triCount);
+        ws.collapseRecords.Reset();
+    }
+
+    ws.vertexMarks.Reset();
+    ws.vertexMarks.SetNumZeroed(vertexCount, false);
+    markStamp = 0;
+}
+
+bool FPMUMeshSimplifier::EvaluateQuadricCollapse(
+    const FVertexView& vertices,
+    const FTriView& triangles,
+    int32 v0,
+    int32 v1,
+    double& outCost,
+    FVector& outPosition
+    )
+{
+    FWorkspace& ws(Workspace);
+
+    const bool bLocked0 = ws.vertexLocked[v0] != 0;
+    const bool bLocked1 = ws.vertexLocked[v1] != 0;
+
+    if (bLocked0 && bLocked1)
+    {
+        return false;
+    }
+
+    const FVertex& vert0(vertices[v0]);
+    const FVertex& vert1(vertices[v1]);
+
+    // Prevent collapses below angle threshold
+    if ((vert0.Normal | vert1.Normal) < Options.MinAngleCosine)
+    {
+        return false;
+    }
+
+    // Prevent collapses above maximum edge size
+    if ((vert1.Position - vert0.Position).SizeSquared() > (Options.MaxEdgeSize * Options.MaxEdgeSize))
+    {
+        return false;
+    }
+
+    FQuadric q(ws.quadrics[v0]);
+    q.Add(ws.quadrics[v1]);
+
+    // Locked vertices keep their position, otherwise pick the cheapest
+    // of the solved position, edge end points and edge mid point
+
+    if (bLocked0 || bLocked1)
+    {
+        outPosition = bLocked0 ? vert0.Position : vert1.Position;
+        outCost = q.Evaluate(outPosition);
+    }
+    else
+    {
+        const FVector candidates[4] = {
+            q.Solve(),
+            vert0.Position,
+            vert1.Position,
+            (vert0.Position + vert1.Position) * 0.5f
+            };
+
+        outCost = MAX_dbl;
+
+        for (const FVector& candidate : candidates)
+        {
+            const double cost = q.Evaluate(candidate);
+
+            if (cost < outCost)
+            {
+                outCost = cost;
+                outPosition = candidate;
+            }
+        }
+    }
+
+    const int32* refs0 = ws.vertexRefs.GetData() + ws.vertexRefStart[v0];
+    const int32* refs1 = ws.vertexRefs.GetData() + ws.vertexRefStart[v1];
+    const int32 refCount0 = ws.vertexRefCount[v0];
+    const int32 refCount1 = ws.vertexRefCount[v1];
+
+    // Link condition, the edge end points may only share the opposite
+    // vertices of the edge triangles to keep the surface manifold
+
+    const uint32 stamp = NextMarkStamp();
+    int32 sharedTriCount = 0;
+    int32 sharedVertexCount = 0;
+
+    for (int32 r=0; r<refCount0; ++r)
+    {
+        const int32 t = refs0[r] / 3;
+
+        if (ws.triRemoved[t])
+        {
+            continue;
+        }
+
+        for (int32 k=0; k<3; ++k)
+        {
+            ws.vertexMarks[triangles[t].indices_[k]] = stamp;
+        }
+    }
+
+    const uint32 sharedStamp = NextMarkStamp();
+
+    for (int32 r=0; r<refCount1; ++r)
+    {
+        const int32 t = refs1[r] / 3;
+
+        if (ws.triRemoved[t])
+        {
+            continue;
+        }
+
+        const int32* indices = triangles[t].indices_;
+
+        if (indices[0] == v0 || indices[1] == v0 || indices[2] == v0)
+        {
+            ++sharedTriCount;
+        }
+
+        for (int32 k=0; k<3; ++k)
+        {
+            const int32 v = indices[k];
+
+            if (v != v0 && v != v1 && ws.vertexMarks[v] == stamp)
+            {
+                ws.vertexMarks[v] = sharedStamp;
+                ++sharedVertexCount;
+            }
+        }
+    }
+
+    if (sharedTriCount != 2 || sharedVertexCount != 2)
+    {
+        return false;
+    }
+
+    // Reject collapses that fold over or degenerate remaining triangles
+
+    for (int32 side=0; side<2; ++side)
+    {
+        const int32 vSrc = side == 0 ? v0 : v1;
+        const int32 vOther = side == 0 ? v1 : v0;
+        const int32* refs = side == 0 ? refs0 : refs1;
+        const int32 refCount = side == 0 ? refCount0 : refCount1;
+
+        for (int32 r=0; r<refCount; ++r)
+        {
+            const int32 corner = refs[r];
+            const int32 t = corner / 3;
+
+            if (ws.triRemoved[t])
+            {
+                continue;
+            }
+
+            const int32* indices = triangles[t].indices_;
+
+            if (indices[0] == vOther || indices[1] == vOther || indices[2] == vOther)
+            {
+                continue;
+            }
+
+            const int32 k = corner % 3;
+            const FVector& pA(vertices[indices[(k+1) % 3]].Position);
+            const FVector& pB(vertices[indices[(k+2) % 3]].Position);
+            const FVector& pSrc(vertices[vSrc].Position);
+
+            const FVector nOld = (pA-pSrc) ^ (pB-pSrc);
+            const FVector nNew = (pA-outPosition) ^ (pB-outPosition);
+
+            const double lenOld = nOld.Size();
+            const double lenNew = nNew.Size();
+
+            if (lenNew <= (lenOld * KINDA_SMALL_NUMBER))
+            {
+                return false;
+            }
+
+            if ((nOld | nNew) < (PMUMeshSimplifier::QUADRIC_FLIP_MIN_COSINE * lenOld * lenNew))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void FPMUMeshSimplifier::UpdateQuadricCollapse(
+    const FVertexView& vertices,
+    const FTriView& triangles,
+    int32 v
+    )
+{
+    FWorkspace& ws(Workspace);
+    PMUMeshSimplifier::FCollapseHeap heap(ws.heap, ws.heapIndex, ws.collapseCost);
+
+    double bestCost = MAX_dbl;
+    int32 bestTarget = INDEX_NONE;
+    FVector bestPosition(ForceInitToZero);
+
+    const int32* refs = ws.vertexRefs.GetData() + ws.vertexRefStart[v];
+    const int32 refCount = ws.vertexRefCount[v];
+
+    // Neighbour candidates are collected first, edge evaluation
+    // overwrites vertex marks through its link condition check
+
+    TArray<int32, TInlineAllocator<32>> neighbours;
+
+    const uint32 stamp = NextMarkStamp();
+    ws.vertexMarks[v] = stamp;
+
+    for (int32 r=0; r<refCount; ++r)
+    {
+        const int32 t = refs[r] / 3;
+
+        if (ws.triRemoved[t])
+        {
+            continue;
+        }
+
+        for (int32 k=0; k<3; ++k)
+        {
+            const int32 n = triangles[t].indices_[k];
+
+            if (ws.vertexMarks[n] != stamp)
+            {
+                ws.vertexMarks[n] = stamp;
+                neighbours.Emplace(n);
+            }
+        }
+    }
+
+    for (int32 n : neighbours)
+    {
+        double cost;
+        FVector position;
+
+        if (EvaluateQuadricCollapse(vertices, triangles, v, n, cost, position))
+        {
+            if (cost < bestCost || (cost == bestCost && n < bestTarget))
+            {
+                bestCost = cost;
+                bestTarget = n;
+                bestPosition = position;
+            }
+        }
+    }
+
+    ws.collapseTarget[v] = bestTarget;
+
+    if (bestTarget != INDEX_NONE)
+    {
+        ws.collapseCost[v] = bestCost;
+        ws.collapsePosition[v] = bestPosition;
+        heap.Update(v);
+    }
+    else
+    {
+        heap.Remove(v);
+    }
+}
+
+int32 FPMUMeshSimplifier::CollapseQuadricEdge(
+    FVertexView& vertices,
+    FTriView& triangles,
+    int32 v0,
+    int32 v1,
+    const FVector& position
+    )
+{
+    FWorkspace& ws(Workspace);
+
+    // Keep locked vertices, the removed vertex is always unlocked
+    const int32 vKeep = ws.vertexLocked[v1] ? v1 : v0;
+    const int32 vRemove = (vKeep == v0) ? v1 : v0;
+
+    FVertex& keep(vertices[vKeep]);
+    const FVertex& remove(vertices[vRemove]);
+
+    keep.Position = position;
+    keep.Normal = (keep.Normal + remove.Normal) * 0.5f;
+
+    ws.quadrics[vKeep].Add(ws.quadrics[vRemove]);
+
+    const int32 collapseStep = ws.collapseRecords.Num();
+
+    if (bRecordCollapses)
+    {
+        ws.collapseRecords.AddDefaulted();
+
+        FPMUMeshCollapseRecord& record(ws.collapseRecords.Last());
+        record.KeepIndex = vKeep;
+        record.RemoveIndex = vRemove;
+        record.Position = keep.Position;
+        record.Normal = keep.Normal;
+    }
+
+    // Rebuild the kept vertex corner list at the end of the ref array,
+    // triangles sharing both vertices are removed and the removed vertex
+    // corners are rewritten to the kept vertex
+
+    int32 removedTriCount = 0;
+
+    const int32 refStart = ws.vertexRefs.Num();
+
+    for (int32 side=0; side<2; ++side)
+    {
+        const int32 v = side == 0 ? vKeep : vRemove;
+        const int32 start = ws.vertexRefStart[v];
+        const int32 count = ws.vertexRefCount[v];
+
+        for (int32 r=0; r<count; ++r)
+        {
+            const int32 corner = ws.vertexRefs[start + r];
+            const int32 t = corner / 3;
+
+            if (ws.triRemoved[t])
+            {
+                continue;
+            }
+
+            int32* indices = triangles[t].indices_;
+
+            if (side == 1)
+            {
+                if (indices[0] == vKeep || indices[1] == vKeep || indices[2] == vKeep)
+                {
+                    ws.triRemoved[t] = 1;
+                    ++removedTriCount;
+
+                    if (bRecordCollapses)
+                    {
+                        ws.triCollapseStep[t] = collapseStep;
+                    }
+                    continue;
+                }
+
+                indices[corner % 3] = vKeep;
+            }
+            else
+            {
+                if (indices[0] == vRemove || indices[1] == vRemove || indices[2] == vRemove)
+                {
+                    continue;
+                }
+            }
+
+            ws.vertexRefs.Emplace(corner);
+        }
+    }
+
+    ws.vertexRefStart[vKeep] = refStart;
+    ws.vertexRefCount[vKeep] = ws.vertexRefs.Num() - refStart;
+    ws.vertexRefCount[vRemove] = 0;
+
+    PMUMeshSimplifier::FCollapseHeap heap(ws.heap, ws.heapIndex, ws.collapseCost);
+    heap.Remove(vRemove);
+    ws.collapseTarget[vRemove] = INDEX_NONE;
+
+    // Quadric and position changes only affect collapse costs of the
+    // kept vertex one ring, stale validity is rechecked on heap pop
+
+    TArray<int32, TInlineAllocator<32>> ring;
+
+    const uint32 stamp = NextMarkStamp();
+
+    for (int32 r=0; r<ws.vertexRefCount[vKeep]; ++r)
+    {
+        const int32 t = ws.vertexRefs[refStart + r] / 3;
+
+        for (int32 k=0; k<3; ++k)
+        {
+            const int32 n = triangles[t].indices_[k];
+
+            if (ws.vertexMarks[n] != stamp)
+            {
+                ws.vertexMarks[n] = stamp;
+                ring.Emplace(n);
+            }
+        }
+    }
+
+    for (int32 n : ring)
+    {
+        UpdateQuadricCollapse(vertices, triangles, n);
+    }
+
+    return removedTriCount;
+}
+
+void FPMUMeshSimplifier::SimplifyQuadric(FVertexView& vertices, FTriView& triangles)
+{
+    SCOPE_CYCLE_COUNTER(STAT_PMUMeshSimplifier_SimplifyQuadric);
+
+    FWorkspace& ws(Workspace);
+
+    const int32 vertexCount = vertices.Num();
+    const int32 triCount = triangles.Num();
+
+    BuildQuadricConnectivity(vertices, triangles);
+
+    ws.collapseTarget.SetNumUninitialized(vertexCount, false);
+    ws.collapsePosition.SetNumUninitialized(vertexCount, false);
+    ws.collapseCost.SetNumUninitialized(vertexCount, false);
+    ws.heapIndex.Init(INDEX_NONE, vertexCount);
+    ws.heap.Reset();
+
+    for (int32 v=0; v<vertexCount; ++v)
+    {
+        UpdateQuadricCollapse(vertices, triangles, v);
+    }
+
+    const int32 targetTriangleCount = (Options.TargetTriangleCount > 0)
+        ? FMath::Min(Options.TargetTriangleCount, triCount)
+        : int32(triCount * Options.TargetPercentage);
+
+    const double maxError = (Options.MaxQuadricError > 0.f)
+        ? double(Options.MaxQuadricError)
+        : MAX_dbl;
+
+    PMUMeshSimplifier::FCollapseHeap heap(ws.heap, ws.heapIndex, ws.collapseCost);
+    int32 liveTriCount = triCount;
+    int32 collapseCount = 0;
+
+    while (liveTriCount > targetTriangleCount && ! heap.IsEmpty())
+    {
+        const int32 v = heap.Top();
+        const double cost = ws.collapseCost[v];
+
+        if (cost > maxError)
+        {
+            break;
+        }
+
+        // Neighbourhood changes beyond the updated one ring might have
+        // invalidated the collapse, re-evaluate and requeue if changed
+
+        const int32 target = ws.collapseTarget[v];
+
+        UpdateQuadricCollapse(vertices, triangles, v);
+
+        if (ws.collapseTarget[v] != target || ws.collapseCost[v] != cost)
+        {
+            continue;
+        }
+
+        liveTriCount -= CollapseQuadricEdge(vertices, triangles, v, target, ws.collapsePosition[v]);
+        ++collapseCount;
+
+        if (bRecordCollapses)
+        {
+            ws.collapseRecords.Last().TriangleCount = liveTriCount;
+        }
+    }
+
+    INC_DWORD_STAT_BY(STAT_PMUMeshSimplifier_QuadricCollapses, collapseCount);
+
+    // Compact remaining triangles in place
+
+    int32 keepCount = 0;
+
+    for (int32 t=0; t<triCount; ++t)
+    {
+        if (! ws.triRemoved[t])
+        {
+            triangles[keepCount++] = triangles[t];
+        }
+    }
+
+    triangles = FTriView(triangles.GetData(), keepCount);
+}
+
+// Progressive Mesh Collapse Sequence
+
+void FPMUMeshSimplifier::BuildCollapseSequence(
+    const FPMUMeshSection& mesh,
+    const FPMUMeshSimplifierOptions& InOptions,
+    FPMUMeshCollapseSequence& OutSequence
+    )
+{
+    OutSequence.Empty();
+
+    const int32 VertexNum = mesh.VertexBuffer.Num();
+    const int32 TriNum = mesh.IndexBuffer.Num() / 3;
+
+    if (VertexNum < 1 || TriNum < 1)
+    {
+        return;
+    }
+
+    // Run the quadric backend to exhaustion on workspace copies
+
+    Options = InOptions;
+    Options.Method = EPMUMeshSimplifierMethod::QuadricPriorityQueue;
+    Options.TargetTriangleCount = 0;
+    Options.TargetPercentage = 0.f;
+
+    lastTriangleCount = TriNum;
+    workspaceTriangleCount = FMath::Max(workspaceTriangleCount, TriNum);
+
+    FWorkspace& ws(Workspace);
+
+    ws.vertices.Reset();
+    ws.vertices.Append(mesh.VertexBuffer);
+
+    ws.triangles.SetNumUninitialized(TriNum, false);
+    FMemory::Memcpy(ws.triangles.GetData(), mesh.IndexBuffer.GetData(), TriNum * sizeof(FTri));
+
+    FVertexView vertices(ws.vertices.GetData(), VertexNum);
+    FTriView triangles(ws.triangles.GetData(), TriNum);
+
+    bRecordCollapses = true;
+    SimplifyQuadric(vertices, triangles);
+    bRecordCollapses = false;
+
+    const TArray<FPMUMeshCollapseRecord>& records(ws.collapseRecords);
+    const int32 CollapseNum = records.Num();
+
+    // Order vertices by removal, never removed vertices first followed by
+    // removed vertices from the last collapse to the first. The vertex
+    // removed by collapse i is placed at VertexNum-1-i.
+
+    TArray<int32>& vertexRemap(ws.vertexRemap);
+    vertexRemap.Init(INDEX_NONE, VertexNum);
+
+    for (int32 i=0; i<CollapseNum; ++i)
+    {
+        vertexRemap[records[i].RemoveIndex] = VertexNum-1-i;
+    }
+
+    for (int32 v=0, LiveIndex=0; v<VertexNum; ++v)
+    {
+        if (vertexRemap[v] == INDEX_NONE)
+        {
+            vertexRemap[v] = LiveIndex++;
+        }
+    }
+
+    OutSequence.VertexBuffer.SetNumUninitialized(VertexNum);
+
+    for (int32 v=0; v<VertexNum; ++v)
+    {
+        OutSequence.VertexBuffer[vertexRemap[v]] = mesh.VertexBuffer[v];
+    }
+
+    // Order triangles by removal in the same fashion, stable by source order
+
+    const TArray<int32>& triCollapseStep(ws.triCollapseStep);
+    TArray<int32> triOrder;
+    triOrder.SetNumUninitialized(TriNum);
+
+    for (int32 t=0; t<TriNum; ++t)
+    {
+        triOrder[t] = t;
+    }
+
+    triOrder.StableSort([&triCollapseStep](const int32 A, const int32 B)
+    {
+        return triCollapseStep[A] > triCollapseStep[B];
+    } );
+
+    OutSequence.IndexBuffer.SetNumUninitialized(TriNum * 3);
+
+    for (int32 i=0; i<TriNum; ++i)
+    {
+        const int32 t = triOrder[i];
+
+        for (int32 k=0; k<3; ++k)
+        {
+            OutSequence.IndexBuffer[i*3 + k] = vertexRemap[mesh.IndexBuffer[t*3 + k]];
+        }
+    }
+
+    OutSequence.Collapses.SetNumUninitialized(CollapseNum);
+
+    for (int32 i=0; i<CollapseNum; ++i)
+    {
+        FPMUMeshCollapseRecord& Record(OutSequence.Collapses[i]);
+        Record = records[i];
+        Record.KeepIndex = vertexRemap[Record.KeepIndex];
+        Record.RemoveIndex = vertexRemap[Record.RemoveIndex];
+    }
+}
+
+int32 FPMUMeshCollapseSequence::GetCollapseCount(int32 TargetTriangleCount) const
+{
+    if (TargetTriangleCount >= GetMaxTriangleCount())
+    {
+        return 0;
+    }
+
+    // Binary search the first collapse at or below the target,
+    // triangle counts are non-increasing along the sequence
+
+    int32 Lo = 0;
+    int32 Hi = Collapses.Num();
+
+    while (Lo < Hi)
+    {
+        const int32 Mid = (Lo + Hi) / 2;
+
+        if (Collapses[Mid].TriangleCount <= TargetTriangleCount)
+        {
+            Hi = Mid;
+        }
+        else
+        {
+            Lo = Mid + 1;
+        }
+    }
+
+    return FMath::Min(Lo + 1, Collapses.Num());
+}
+
+void FPMUMeshCollapseSequence::GenerateSection(int32 TargetTriangleCount, FPMUMeshSection& OutSection) const
+{
+    const int32 CollapseCount = GetCollapseCount(TargetTriangleCount);
+    const int32 VertexNum = VertexBuffer.Num();
+    const int32 LiveVertexNum = VertexNum - CollapseCount;
+    const int32 LiveTriNum = (CollapseCount > 0) ? Collapses[CollapseCount-1].TriangleCount : GetMaxTriangleCount();
+
+    // Live vertices are the base vertex buffer prefix with collapsed attributes
+
+    TArray<FPMUMeshVertex>& DstVertexBuffer(OutSection.VertexBuffer);
+    DstVertexBuffer.Reset(LiveVertexNum);
+    DstVertexBuffer.Append(VertexBuffer.GetData(), LiveVertexNum);
+
+    for (int32 i=0; i<CollapseCount; ++i)
+    {
+        const FPMUMeshCollapseRecord& Record(Collapses[i]);
+
+        if (Record.KeepIndex < LiveVertexNum)
+        {
+            FPMUMeshVertex& Vertex(DstVertexBuffer[Record.KeepIndex]);
+            Vertex.Position = Record.Position;
+            Vertex.Normal = Record.Normal;
+        }
+    }
+
+    // Resolve removed vertices to their live collapse targets. Later collapses
+    // are resolved first, a removed target always has a later removal.
+
+    TArray<int32> RemovedTargets;
+    RemovedTargets.SetNumUninitialized(CollapseCount);
+
+    for (int32 i=CollapseCount-1; i>=0; --i)
+    {
+        const int32 KeepIndex = Collapses[i].KeepIndex;
+        RemovedTargets[i] = (KeepIndex < LiveVertexNum)
+            ? KeepIndex
+            : RemovedTargets[VertexNum-1-KeepIndex];
+    }
+
+    TArray<int32>& DstIndexBuffer(OutSection.IndexBuffer);
+    DstIndexBuffer.SetNumUninitialized(LiveTriNum * 3);
+
+    for (int32 i=0; i<(LiveTriNum*3); ++i)
+    {
+        const int32 Index = IndexBuffer[i];
+        DstIndexBuffer[i] = (Index < LiveVertexNum) ? Index : RemovedTargets[VertexNum-1-Index];
+    }
+
+    OutSection.LocalBox.Init();
+
+    for (const FPMUMeshVertex& Vertex : DstVertexBuffer)
+    {
+        OutSection.LocalBox += Vertex.Position;
+    }
 }
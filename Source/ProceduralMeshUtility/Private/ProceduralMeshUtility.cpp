@@ -30,6 +30,8 @@
 #include "ProceduralMeshUtilitySettings.h"
 #include "GenericWorkerThread.h"
 #include "GWTAsyncThreadManager.h"
+#include "Misc/QueuedThreadPool.h"
+#include "Misc/ScopeLock.h"
 
 #if WITH_EDITOR
 #include "ISettingsModule.h"
@@ -63,6 +65,9 @@ class FProceduralMeshUtility : public IProceduralMeshUtility
     FGWTAsyncThreadPoolWeakInstance ThreadPool;
     bool bThreadPoolRequireUpdate = true;
 
+    FQueuedThreadPool* BackgroundThreadPool = nullptr;
+    FCriticalSection BackgroundThreadPoolLock;
+
 #if WITH_EDITOR
 
     bool HandleSettingsModified()
@@ -136,6 +141,14 @@ public:
 #if WITH_EDITOR
         UnregisterSettings();
 #endif // WITH_EDITOR
+
+        // Queued background work is completed on pool destruction
+        if (BackgroundThreadPool)
+        {
+            BackgroundThreadPool->Destroy();
+            delete BackgroundThreadPool;
+            BackgroundThreadPool = nullptr;
+        }
     }
 
 	FORCEINLINE virtual FPSGWTAsyncThreadPool GetThreadPool() override
@@ -147,6 +160,22 @@ public:
         return ThreadPool.Pin(IGenericWorkerThread::Get().GetAsyncThreadManager());
     }
 
+	virtual FQueuedThreadPool* GetBackgroundThreadPool() override
+    {
+        FScopeLock ScopeLock(&BackgroundThreadPoolLock);
+
+        if (! BackgroundThreadPool)
+        {
+            const UProceduralMeshUtilitySettings& Settings = *GetDefault<UProceduralMeshUtilitySettings>();
+            const uint32 ThreadCount = FMath::Max(1, Settings.BackgroundThreadCount);
+
+            BackgroundThreadPool = FQueuedThreadPool::Allocate();
+            verify(BackgroundThreadPool->Create(ThreadCount, 128 * 1024, TPri_Lowest));
+        }
+
+        return BackgroundThreadPool;
+    }
+
 #ifdef PMU_VOXEL_USE_OCL
 
     // GPU PROGRAM STORAGE
@@ -41,4 +41,8 @@ public:
     // Available thread for voxel mesh rendering
     UPROPERTY(EditAnywhere, Config, Category="Thread Pool", Meta=(UIMin=1, ClampMin=1, DisplayName="Thread Count"))
     int32 ThreadCount = 4;
+
+    // Available lowest priority thread for deferred voxel mesh simplification
+    UPROPERTY(EditAnywhere, Config, Category="Thread Pool", Meta=(UIMin=1, ClampMin=1, DisplayName="Background Thread Count"))
+    int32 BackgroundThreadCount = 1;
 };
@@ -37,6 +37,7 @@ public class ProceduralMeshUtility: ModuleRules
 
         //PublicDefinitions.Add("PMU_SUBSTANCE_ENABLED");
         //PublicDefinitions.Add("PMU_LINE_SIMPLIFY_VIS_CHECK_HEAP_CONSISTENCY");
+        //PublicDefinitions.Add("PMU_VOXEL_CHECK_HEIGHT_SAMPLING");
         PublicDefinitions.Add("PMU_LINE_SIMPLIFY_VIS_CHECK_INSTANCE_MEMORY");
 
         // Get the engine path. Ends with "Engine/"
@@ -50,6 +50,9 @@ public:
 
 	virtual TSharedPtr<class FGWTAsyncThreadPool> GetThreadPool() = 0;
 
+    // Lowest priority thread pool for deferred background work
+	virtual class FQueuedThreadPool* GetBackgroundThreadPool() = 0;
+
 #ifdef PMU_VOXEL_USE_OCL
 
 	virtual bool HasGPUProgram(const FName& ProgramName) const = 0;